@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_CONTENT_HASH_H
+#define PASTE_BOARD_CONTENT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace MiscServices {
+/**
+ * XXH64 of byte ranges, for cheap equality of paste data content. Not a cryptographic hash, equal
+ * fingerprints mean equal content only with high probability.
+ */
+class ContentHash {
+public:
+    /**
+     * Hash64
+     * @descrition Hash a byte range, the result is the XXH64 digest for the seed.
+     * @return uint64_t the hash.
+     */
+    static uint64_t Hash64(const void *data, std::size_t length, uint64_t seed = 0);
+};
+} // MiscServices
+} // OHOS
+#endif // PASTE_BOARD_CONTENT_HASH_H
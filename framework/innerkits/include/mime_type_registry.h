@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_MIME_TYPE_REGISTRY_H
+#define PASTE_BOARD_MIME_TYPE_REGISTRY_H
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace OHOS {
+namespace MiscServices {
+using MimeTypeId = std::uint32_t;
+
+enum : MimeTypeId {
+    MIME_ID_TEXT_HTML = 0,
+    MIME_ID_TEXT_PLAIN,
+    MIME_ID_TEXT_URI,
+    MIME_ID_TEXT_WANT,
+    MIME_ID_BUILTIN_COUNT,
+    // ids fit one bit of a uint64_t bitmap
+    MIME_ID_MAX = 64,
+    MIME_ID_INVALID = MIME_ID_MAX,
+};
+
+/**
+ * Interns mime type strings to small process-wide ids so records and paste data can compare
+ * and index types without string compares. The builtin types always have their fixed ids.
+ */
+class MimeTypeRegistry {
+public:
+    static MimeTypeRegistry &GetInstance();
+
+    /**
+     * Register
+     * @descrition Get the id of a mime type, interning it on first use.
+     * @return MimeTypeId the id, MIME_ID_INVALID once the registry is full.
+     */
+    MimeTypeId Register(const std::string &mimeType);
+
+    /**
+     * Find
+     * @descrition Get the id of a mime type without interning it.
+     * @return MimeTypeId the id, MIME_ID_INVALID if the type was never registered.
+     */
+    MimeTypeId Find(const std::string &mimeType) const;
+
+    /**
+     * GetName
+     * @descrition Get the mime type string of an id, the reference stays valid for the process lifetime.
+     * @return const std::string& the mime type, empty for MIME_ID_INVALID or an unknown id.
+     */
+    const std::string &GetName(MimeTypeId id) const;
+
+private:
+    MimeTypeRegistry();
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, MimeTypeId> ids_;
+    // indexed by id, a deque so references handed out by GetName survive later registrations
+    std::deque<std::string> names_;
+};
+} // MiscServices
+} // OHOS
+#endif // PASTE_BOARD_MIME_TYPE_REGISTRY_H
@@ -15,9 +15,11 @@
 #ifndef PASTE_BOARD_DATA_H
 #define PASTE_BOARD_DATA_H
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -33,21 +35,29 @@ struct PasteDataProperty {
     AAFwk::WantParams additions;
     std::vector<std::string> mimeTypes;
     std::string tag;
-    std::int64_t timestamp;
-    bool localOnly;
+    // milliseconds since epoch
+    std::int64_t timestamp = 0;
+    bool localOnly = false;
 };
 
 class PasteData : public Parcelable {
 public:
     PasteData() = default;
     explicit PasteData(std::vector<std::shared_ptr<PasteDataRecord>> records);
+    PasteData(const PasteData &data) = default;
+    PasteData(PasteData &&data);
+    PasteData &operator=(const PasteData &data) = default;
+    PasteData &operator=(PasteData &&data);
 
     void AddHtmlRecord(const std::string &html);
+    void AddHtmlRecord(std::string &&html);
     void AddTextRecord(const std::string &text);
+    void AddTextRecord(std::string &&text);
     void AddUriRecord(const OHOS::Uri &uri);
     void AddWantRecord(std::shared_ptr<OHOS::AAFwk::Want> want);
     void AddRecord(std::shared_ptr<PasteDataRecord> record);
     void AddRecord(PasteDataRecord& record);
+    void AddRecord(PasteDataRecord &&record);
     std::vector<std::string> GetMimeTypes();
     std::shared_ptr<std::string> GetPrimaryHtml();
     std::shared_ptr<std::string> GetPrimaryText();
@@ -60,17 +70,100 @@ public:
     bool RemoveRecordAt(std::size_t number);
     bool ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRecord> record);
     bool HasMimeType(const std::string &mimeType);
+
+    /**
+     * GetProperty
+     * @descrition Get the clip properties, with the mime types of the records in order.
+     * @return PasteDataProperty the properties.
+     */
     PasteDataProperty GetProperty();
     std::vector<std::shared_ptr<PasteDataRecord>> AllRecords() const;
 
+    /**
+     * PeekRecordAt
+     * @descrition Get a record as it is held, without decoding it. A record read lazily stays encoded, it
+     * only answers GetMimeType, the size getters and Marshalling, enough to pass it on.
+     * @return std::shared_ptr<PasteDataRecord> the record, nullptr if the index is out of range.
+     */
+    std::shared_ptr<PasteDataRecord> PeekRecordAt(std::size_t index) const;
+
+    /**
+     * PeekFirstRecord
+     * @descrition Get the newest record of a mime type as it is held, see PeekRecordAt.
+     * @return std::shared_ptr<PasteDataRecord> the record, nullptr if there is none of that type.
+     */
+    std::shared_ptr<PasteDataRecord> PeekFirstRecord(const std::string &mimeType) const;
+
+    /**
+     * GetFingerprint
+     * @descrition Get the hash of the record fingerprints in order, records read lazily are decoded for it.
+     * @return uint64_t the fingerprint, equal for clips with equal records in the same order.
+     */
+    uint64_t GetFingerprint();
+
+    /**
+     * GetContentSize
+     * @descrition Get the sum of the record content sizes, records read lazily stay encoded.
+     * @return uint64_t the size in bytes.
+     */
+    uint64_t GetContentSize() const;
+
+    /**
+     * SerializedSize
+     * @descrition Get the number of bytes Marshalling writes, exact for text and uri records. Want records are
+     * counted with a fixed size hint, an upper-bound estimate that a want with many parameters can exceed,
+     * the parcel then grows while writing it.
+     * @return std::size_t the size in bytes.
+     */
+    std::size_t SerializedSize(uint32_t version = PASTE_DATA_WIRE_V1) const;
+
     virtual bool Marshalling(Parcel &parcel) const override;
+    bool Marshalling(Parcel &parcel, uint32_t version) const;
     static PasteData *Unmarshalling(Parcel &parcel);
 
+    /**
+     * Unmarshalling
+     * @descrition Read paste data, in lazy mode only the mime types are decoded up front. The records keep
+     * their parcel bytes and are decoded on first GetRecordAt or GetPrimary* call, AllRecords decodes copies.
+     * @return PasteData* the paste data, nullptr if the parcel is malformed.
+     */
+    static PasteData *Unmarshalling(Parcel &parcel, bool lazy);
+
 private:
-    void RefreshMimeProp();
-    bool ReadFromParcel(Parcel &parcel);
+    void IndexFront(const std::shared_ptr<PasteDataRecord> &record);
+    void IndexBack(const std::shared_ptr<PasteDataRecord> &record);
+    void UnindexBack(const std::shared_ptr<PasteDataRecord> &record);
+    void RebuildMimeIndex();
+    std::shared_ptr<PasteDataRecord> GetFirstRecord(MimeTypeId id);
+    const std::shared_ptr<PasteDataRecord> &Materialize(std::size_t index);
+    bool ReadFromParcel(Parcel &parcel, bool lazy);
+    bool MarshallingUtf8(Parcel &parcel, uint32_t version) const;
+    bool MarshallingParallel(Parcel &parcel) const;
+    std::vector<std::shared_ptr<PasteDataRecord>> DecodeRecords(uint32_t version) const;
     PasteDataProperty props_;
-    std::vector<std::shared_ptr<PasteDataRecord>> records_;
+    // newest record first, bounded by MAX_RECORD_NUM
+    std::deque<std::shared_ptr<PasteDataRecord>> records_;
+    // mime index over records_: a bit and a record count per registered mime type id, plus the position of
+    // the first record of each builtin type. Positions are relative to frontPos_, which moves down on every
+    // front insertion so existing positions stay valid.
+    std::uint64_t mimeBitmap_ = 0;
+    std::array<std::uint16_t, MIME_ID_MAX> mimeCounts_ {};
+    std::array<std::int64_t, MIME_ID_BUILTIN_COUNT> firstPos_ {};
+    std::int64_t frontPos_ = 0;
+};
+
+// Lets WriteParcelable send a PasteData in the wire version negotiated with the peer.
+class VersionedPasteData : public Parcelable {
+public:
+    VersionedPasteData(const PasteData &data, uint32_t version) : data_(data), version_(version) {}
+    virtual bool Marshalling(Parcel &parcel) const override
+    {
+        return data_.Marshalling(parcel, version_);
+    }
+
+private:
+    const PasteData &data_;
+    uint32_t version_;
 };
 } // MiscServices
 } // OHOS
@@ -17,7 +17,12 @@
 #define PASTE_BOARD_RECORD_H
 
 #include <memory>
+#include <array>
 #include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "mime_type_registry.h"
 #include "parcel.h"
 #include "string_ex.h"
 #include "uri.h"
@@ -32,8 +37,23 @@ const std::string MIMETYPE_TEXT_URI = "text/uri";
 const std::string MIMETYPE_TEXT_WANT = "text/want";
 }
 
+// Parcel layouts of PasteData. V1 sends text as UTF-16 and is what every peer understands, V2 sends UTF-8
+// bytes as length-prefixed buffers, V3 is V2 with large text in shared memory passed as a file descriptor.
+// Readers detect the layout, writers use a newer one only once the peer announced it.
+enum : uint32_t {
+    PASTE_DATA_WIRE_V1 = 1,
+    PASTE_DATA_WIRE_V2 = 2,
+    PASTE_DATA_WIRE_V3 = 3,
+    PASTE_DATA_WIRE_LATEST = PASTE_DATA_WIRE_V3,
+};
+
+class SharedText;
+
 class PasteDataRecord : public Parcelable {
 public:
+    // Html and plain text records hold less than this many bytes.
+    static constexpr std::size_t MAX_TEXT_SIZE = 500 * 1024;
+
     PasteDataRecord() = default;
 
     PasteDataRecord(std::string mimeType,
@@ -43,11 +63,22 @@ public:
                     std::shared_ptr<OHOS::Uri> uri);
 
     static std::shared_ptr<PasteDataRecord> NewHtmlRecord(const std::string &htmlText);
+    static std::shared_ptr<PasteDataRecord> NewHtmlRecord(std::string &&htmlText);
     static std::shared_ptr<PasteDataRecord> NewWantRecord(std::shared_ptr<OHOS::AAFwk::Want> want);
     static std::shared_ptr<PasteDataRecord> NewPlaintTextRecord(const std::string &text);
+    static std::shared_ptr<PasteDataRecord> NewPlaintTextRecord(std::string &&text);
     static std::shared_ptr<PasteDataRecord> NewUriRecord(const OHOS::Uri &uri);
 
-    std::string GetMimeType() const;
+    /**
+     * NewSharedTextRecord
+     * @descrition Make an html or plain text record of text already in a sealed region, without copying it.
+     * @return std::shared_ptr<PasteDataRecord> the record, nullptr for another type or too much text.
+     */
+    static std::shared_ptr<PasteDataRecord> NewSharedTextRecord(const std::string &mimeType,
+        std::shared_ptr<const SharedText> text);
+
+    const std::string &GetMimeType() const;
+    MimeTypeId GetMimeTypeId() const;
     std::shared_ptr<std::string> GetHtmlText() const;
     std::shared_ptr<std::string> GetPlainText() const;
     std::shared_ptr<OHOS::Uri> GetUri() const;
@@ -55,16 +86,95 @@ public:
 
     std::string ConvertToText() const;
 
+    /**
+     * GetFingerprint
+     * @descrition Get the hash of the mime type and content, taken when the record was created or decoded.
+     * Changing the text through a returned pointer afterwards is not reflected.
+     * @return uint64_t the fingerprint, equal for records of equal type and content.
+     */
+    uint64_t GetFingerprint() const;
+
+    /**
+     * GetContentSize
+     * @descrition Get the size of the text, uri or want uri as UTF-8, known without decoding a record read lazily.
+     * @return std::size_t the size in bytes.
+     */
+    std::size_t GetContentSize() const;
+
+    /**
+     * GetContent
+     * @descrition Get the content GetContentSize counts, valid while owner is held. Text held as UTF-8 or in
+     * shared memory is not copied, other payloads are converted once, a record read lazily is not changed.
+     * @return std::string_view the content, empty when the record has none.
+     */
+    std::string_view GetContent(std::shared_ptr<const void> &owner) const;
+
+    /**
+     * SerializedSize
+     * @descrition Get the number of bytes Marshalling writes for this record. Text in shared memory counts its
+     * fixed descriptor, a want a fixed size hint, an upper-bound estimate a want with many parameters can exceed.
+     * @return std::size_t the size in bytes.
+     */
+    std::size_t SerializedSize(uint32_t version = PASTE_DATA_WIRE_V1) const;
+
     virtual bool Marshalling(Parcel &parcel) const override;
+    bool Marshalling(Parcel &parcel, uint32_t version) const;
     static PasteDataRecord *Unmarshalling(Parcel &parcel);
+    static PasteDataRecord *Unmarshalling(Parcel &parcel, uint32_t version);
 
 private:
-    bool ReadFromParcel(Parcel &parcel);
-    std::string mimeType_;
-    std::shared_ptr<std::string> htmlText_;
-    std::shared_ptr<OHOS::AAFwk::Want> want_;
-    std::shared_ptr<std::string> plainText_;
-    std::shared_ptr<OHOS::Uri> uri_;
+    friend class PasteData;
+    template<MimeTypeId id>
+    friend struct RecordCodec;
+    template<std::size_t index>
+    friend struct TextRecordCodec;
+
+    // A record read lazily stays encoded in the parcel bytes its paste data kept, until first used.
+    struct EncodedPayload {
+        std::shared_ptr<const std::vector<uint8_t>> buffer;
+        std::size_t offset;
+        std::size_t size;
+        uint32_t version;
+    };
+
+    // Short html, plain text or uri held in the record itself, so such a record takes a single allocation.
+    struct InlineText {
+        static constexpr std::size_t CAPACITY = 47;
+        uint8_t size = 0;
+        std::array<char, CAPACITY> data;
+        std::string_view View() const
+        {
+            return std::string_view(data.data(), size);
+        }
+    };
+
+    // A record holds exactly one payload, the variant index tells which one. Html or plain text that came
+    // in shared memory stays there, and short text of a builtin type is inline, their getters return copies.
+    enum : std::size_t {
+        PAYLOAD_NONE = 0, PAYLOAD_HTML, PAYLOAD_PLAIN, PAYLOAD_URI, PAYLOAD_WANT, PAYLOAD_ENCODED, PAYLOAD_SHARED,
+        PAYLOAD_INLINE
+    };
+    using Payload = std::variant<std::monostate, std::shared_ptr<std::string>, std::shared_ptr<std::string>,
+        std::shared_ptr<OHOS::Uri>, std::shared_ptr<OHOS::AAFwk::Want>, std::shared_ptr<const EncodedPayload>,
+        std::shared_ptr<const SharedText>, InlineText>;
+
+    static std::shared_ptr<PasteDataRecord> ReadEncoded(Parcel &parcel, uint32_t version,
+        const std::shared_ptr<const std::vector<uint8_t>> &buffer, std::size_t base);
+    static std::shared_ptr<PasteDataRecord> NewTextRecord(MimeTypeId id, std::string &&text);
+    bool EmplaceInline(std::string_view text);
+    const InlineText *GetInline(MimeTypeId id) const;
+    bool IsEncoded() const;
+    std::size_t GetDecodeSize(uint32_t version) const;
+    std::shared_ptr<std::string> GetText(std::size_t payload, MimeTypeId id) const;
+    std::shared_ptr<PasteDataRecord> Decode() const;
+    bool ReadFromParcel(Parcel &parcel, uint32_t version);
+    void UpdateSummary();
+    MimeTypeId mimeTypeId_ = MIME_ID_INVALID;
+    uint64_t fingerprint_ = 0;
+    std::size_t contentSize_ = 0;
+    // only set for a type the registry could not intern
+    std::shared_ptr<const std::string> customMimeType_;
+    Payload payload_;
 };
 } // MiscServices
 } // OHOS
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_DATA_SUMMARY_H
+#define PASTE_BOARD_DATA_SUMMARY_H
+
+#include <cstdint>
+#include <vector>
+#include "paste_data.h"
+#include "parcel.h"
+
+namespace OHOS {
+namespace MiscServices {
+// What a reader can learn about the current clip without fetching any record.
+class PasteDataSummary : public Parcelable {
+public:
+    PasteDataSummary() = default;
+
+    virtual bool Marshalling(Parcel &parcel) const override;
+    static PasteDataSummary *Unmarshalling(Parcel &parcel);
+
+    // Mime types in record order, the timestamp is when the clip was set, in milliseconds since epoch.
+    PasteDataProperty property;
+    // UTF-8 content size of each record, in record order.
+    std::vector<std::uint64_t> recordSizes;
+
+private:
+    bool ReadFromParcel(Parcel &parcel);
+};
+} // MiscServices
+} // OHOS
+#endif // PASTE_BOARD_DATA_SUMMARY_H
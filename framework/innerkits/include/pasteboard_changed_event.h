@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_CHANGED_EVENT_H
+#define PASTE_BOARD_CHANGED_EVENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "parcel.h"
+
+namespace OHOS {
+namespace MiscServices {
+class PasteboardChangedEvent : public Parcelable {
+public:
+    PasteboardChangedEvent() = default;
+
+    virtual bool Marshalling(Parcel &parcel) const override;
+    static PasteboardChangedEvent *Unmarshalling(Parcel &parcel);
+
+    // Per-user change sequence number, increased by every set or clear.
+    std::uint64_t seq = 0;
+    std::vector<std::string> mimeTypes;
+    std::uint32_t recordCount = 0;
+    std::uint64_t totalBytes = 0;
+    std::string bundleName;
+    // Milliseconds since epoch.
+    std::int64_t timestamp = 0;
+
+private:
+    bool ReadFromParcel(Parcel &parcel);
+};
+} // MiscServices
+} // OHOS
+#endif // PASTE_BOARD_CHANGED_EVENT_H
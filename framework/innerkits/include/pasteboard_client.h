@@ -47,6 +47,7 @@ public:
      * @return PasteDataRecord.
      */
     std::shared_ptr<PasteDataRecord> CreateHtmlTextRecord(const std::string &text);
+    std::shared_ptr<PasteDataRecord> CreateHtmlTextRecord(std::string &&text);
 
     /**
      * CreatePlainTextRecord
@@ -55,6 +56,7 @@ public:
      * @return PasteDataRecord.
      */
     std::shared_ptr<PasteDataRecord> CreatePlainTextRecord(const std::string &text);
+    std::shared_ptr<PasteDataRecord> CreatePlainTextRecord(std::string &&text);
 
     /**
      * CreateUriRecord
@@ -79,6 +81,7 @@ public:
      * @return PasteData.
      */
     std::shared_ptr<PasteData> CreateHtmlData(const std::string &htmlText);
+    std::shared_ptr<PasteData> CreateHtmlData(std::string &&htmlText);
 
     /**
      * CreatePlainTextData
@@ -87,6 +90,7 @@ public:
      * @return PasteData.
      */
     std::shared_ptr<PasteData> CreatePlainTextData(const std::string &text);
+    std::shared_ptr<PasteData> CreatePlainTextData(std::string &&text);
 
     /**
      * CreateUriData
@@ -117,6 +121,113 @@ public:
      */
     bool HasPasteData();
 
+    /**
+     * GetChangeCount
+     * @descrition Get the change sequence number of the current user's pasteboard.
+     * It is increased by every set and clear, compare it to detect changes without fetching the data.
+     * @return int64_t the change count, -1 on failure.
+     */
+    int64_t GetChangeCount();
+
+    /**
+     * GetPasteDataIfChanged
+     * @descrition Get the paste data only when it changed since the given change count.
+     * @param changeCount in: the last seen change count, out: the current change count.
+     * @param pasteData filled only when modified is true and the pasteboard has data.
+     * @param modified whether the pasteboard changed since changeCount.
+     * @return bool true if the pasteboard has data, false otherwise.
+     */
+    bool GetPasteDataIfChanged(int64_t &changeCount, PasteData &pasteData, bool &modified);
+
+    /**
+     * GetPasteDataSummary
+     * @descrition Get the properties, mime types and record sizes of the paste data, without its records.
+     * @return bool true if the pasteboard has data, false otherwise.
+     */
+    bool GetPasteDataSummary(PasteDataSummary &summary);
+
+    /**
+     * GetRecordAt
+     * @descrition Get a single record of the paste data, only that record is transferred.
+     * @return std::shared_ptr<PasteDataRecord> the record, nullptr if there is no such record.
+     */
+    std::shared_ptr<PasteDataRecord> GetRecordAt(std::size_t index);
+
+    /**
+     * GetFirstRecord
+     * @descrition Get the newest record of a mime type, only that record is transferred.
+     * @return std::shared_ptr<PasteDataRecord> the record, nullptr if there is none of that type.
+     */
+    std::shared_ptr<PasteDataRecord> GetFirstRecord(const std::string &mimeType);
+
+    /**
+     * OpenRecordReader
+     * @descrition Open a record for reading its content in chunks, the content GetContentSize counts.
+     * The reader keeps the content it was opened on, close it when done. Opening a fifth reader closes the
+     * process's oldest one, and readers are closed when the process dies.
+     * @param mimeType out: the mime type of the record.
+     * @param size out: the content size in bytes.
+     * @return uint32_t the reader id, 0 if there is no such record or the pasteboard has too many readers open.
+     */
+    uint32_t OpenRecordReader(std::size_t index, std::string &mimeType, uint64_t &size);
+
+    /**
+     * ReadRecordChunk
+     * @descrition Read up to length bytes from offset, at most MAX_RECORD_CHUNK_SIZE. A chunk ends on a UTF-8
+     * character boundary, so it can be shorter than asked for, the next read continues after it. A length
+     * shorter than the next character still reads that whole character.
+     * @param chunk out: the bytes read, empty at the end of the content.
+     * @return bool true on success, false if the reader is not open or offset is past the end.
+     */
+    bool ReadRecordChunk(uint32_t readerId, uint64_t offset, uint32_t length, std::string &chunk);
+
+    /**
+     * CloseRecordReader
+     * @descrition Close a reader opened by OpenRecordReader.
+     * @return void.
+     */
+    void CloseRecordReader(uint32_t readerId);
+
+    /**
+     * BeginPasteWriter
+     * @descrition Begin a copy written record by record in chunks, the pasteboard keeps its data until
+     * CommitPasteWriter publishes it as a whole or AbortPasteWriter drops it. Beginning a third writer aborts
+     * the process's oldest one, and writers are aborted when the process dies.
+     * @return uint32_t the writer id, 0 on failure or when the pasteboard has too many writers open.
+     */
+    uint32_t BeginPasteWriter();
+
+    /**
+     * AddWriterRecord
+     * @descrition Start the next record of a writer, the first one added is the primary record. Its content
+     * must be written in full before the next record is added or the writer is committed.
+     * @param mimeType MIMETYPE_TEXT_PLAIN or MIMETYPE_TEXT_HTML.
+     * @param size the content size in bytes, below PasteDataRecord::MAX_TEXT_SIZE.
+     * @return bool true on success, false otherwise, the writer can then no longer be committed.
+     */
+    bool AddWriterRecord(uint32_t writerId, const std::string &mimeType, uint64_t size);
+
+    /**
+     * WriteRecordChunk
+     * @descrition Append UTF-8 bytes to the record being written, longer data is sent in several chunks.
+     * @return bool true on success, false otherwise, the writer can then no longer be committed.
+     */
+    bool WriteRecordChunk(uint32_t writerId, const char *data, std::size_t size);
+
+    /**
+     * CommitPasteWriter
+     * @descrition Publish the records of a writer as the new paste data, the writer is closed either way.
+     * @return bool true on success, false if the writer failed or a record is incomplete or not UTF-8.
+     */
+    bool CommitPasteWriter(uint32_t writerId);
+
+    /**
+     * AbortPasteWriter
+     * @descrition Drop a writer and everything written to it, a commit of it after this returns fails.
+     * @return void.
+     */
+    void AbortPasteWriter(uint32_t writerId);
+
     /**
      * Clear
      * @descrition Clear Current pasteboard data
@@ -136,9 +247,11 @@ public:
      * AddPasteboardChangedObserver
      * @descrition
      * @param observer pasteboard change callback.
+     * @param mimeTypes only notify changes involving one of these mime types, empty for all changes.
      * @return void.
      */
-    void AddPasteboardChangedObserver(std::shared_ptr<PasteboardObserver> callback);
+    void AddPasteboardChangedObserver(std::shared_ptr<PasteboardObserver> callback,
+        const std::vector<std::string> &mimeTypes = {});
 
     /**
      * RemovePasteboardChangedObserver
@@ -148,6 +261,22 @@ public:
      */
     void RemovePasteboardChangedObserver(std::shared_ptr<PasteboardObserver> callback);
 
+    /**
+     * AddPasteboardEventObserver
+     * @descrition Observe pasteboard changes of all users, only allowed for system processes.
+     * @param observer pasteboard change callback.
+     * @return void.
+     */
+    void AddPasteboardEventObserver(std::shared_ptr<PasteboardObserver> callback);
+
+    /**
+     * RemovePasteboardEventObserver
+     * @descrition
+     * @param observer pasteboard change callback.
+     * @return void.
+     */
+    void RemovePasteboardEventObserver(std::shared_ptr<PasteboardObserver> callback);
+
     void OnRemoteSaDied(const wptr<IRemoteObject> &object);
 private:
     void ConnectService();
@@ -156,6 +285,8 @@ private:
     static std::mutex instanceLock_;
 
     sptr<IRemoteObject::DeathRecipient> deathRecipient_ {nullptr};
+    // Sent with every reader and writer opened, the service drops them when it dies with this process.
+    sptr<IRemoteObject> sessionToken_ {nullptr};
 };
 } // MiscServices
 } // OHOS
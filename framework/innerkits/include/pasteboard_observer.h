@@ -23,6 +23,7 @@ class PasteboardObserver : public PasteboardObserverStub {
 public:
     PasteboardObserver();
     ~PasteboardObserver();
+    using PasteboardObserverStub::OnPasteboardChanged;
     void OnPasteboardChanged() override;
 };
 } // MiscServices
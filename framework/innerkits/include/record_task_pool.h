@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_RECORD_TASK_POOL_H
+#define PASTE_BOARD_RECORD_TASK_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace MiscServices {
+/**
+ * A few worker threads shared by the paste data codec, so records of a large clip are transcoded side by side
+ * instead of one after another on the IPC thread. Small clips stay on the calling thread, where handing work
+ * over costs more than it saves.
+ */
+class RecordTaskPool {
+public:
+    static RecordTaskPool &GetInstance();
+
+    /**
+     * ShouldSplit
+     * @descrition Whether count records holding bytes bytes in total are worth coding in parallel.
+     * @return bool true above the size threshold with more than one record.
+     */
+    bool ShouldSplit(std::size_t count, std::size_t bytes) const;
+
+    /**
+     * SetMinBytes
+     * @descrition Set the size threshold of ShouldSplit, for tuning and benchmarks.
+     */
+    void SetMinBytes(std::size_t bytes);
+
+    /**
+     * ParallelFor
+     * @descrition Run task for every index below count and wait for all of them. The calling thread takes
+     * indices as well, so the call completes even when every worker is busy.
+     */
+    void ParallelFor(std::size_t count, const std::function<void(std::size_t)> &task);
+
+private:
+    RecordTaskPool();
+    ~RecordTaskPool();
+    std::once_flag started_;
+    ThreadPool pool_;
+    std::size_t threads_ = 0;
+    bool running_ = false;
+    std::atomic<std::size_t> minBytes_;
+};
+} // MiscServices
+} // OHOS
+#endif // PASTE_BOARD_RECORD_TASK_POOL_H
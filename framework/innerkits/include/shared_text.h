@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_SHARED_TEXT_H
+#define PASTE_BOARD_SHARED_TEXT_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "ashmem.h"
+#include "parcel.h"
+
+namespace OHOS {
+namespace MiscServices {
+/**
+ * Text in a read-only shared memory region. A parcel carries the region's file descriptor instead of the bytes,
+ * so every process holding the text maps the same pages. Regions are memfds sealed against writes and resizing
+ * before they are sent, and a region without those seals is refused when read, so no process can change the
+ * text once it was received.
+ */
+class SharedText {
+public:
+    // Smallest text worth a region of its own, shorter text is sent inline.
+    static constexpr std::size_t MIN_SIZE = 32 * 1024;
+
+    SharedText(sptr<Ashmem> ashmem, std::size_t size);
+    ~SharedText();
+
+    /**
+     * Create
+     * @descrition Copy the text into a new sealed region.
+     * @return std::shared_ptr<const SharedText> the region, nullptr when it could not be created.
+     */
+    static std::shared_ptr<const SharedText> Create(const char *data, std::size_t size);
+
+    /**
+     * Unmarshalling
+     * @descrition Map the region a parcel refers to, it must be sealed, exactly the size it announces and
+     * below PasteDataRecord::MAX_TEXT_SIZE.
+     * @return std::shared_ptr<const SharedText> the region, nullptr when it is missing or not usable.
+     */
+    static std::shared_ptr<const SharedText> Unmarshalling(Parcel &parcel);
+
+    /**
+     * Marshalling
+     * @descrition Write the size and a duplicate of the region's file descriptor.
+     * @return bool true on success.
+     */
+    bool Marshalling(Parcel &parcel) const;
+
+    const char *GetData() const;
+    std::size_t GetSize() const;
+
+private:
+    sptr<Ashmem> ashmem_;
+    std::size_t size_ = 0;
+    const char *data_ = nullptr;
+};
+
+/**
+ * Fills a writable region piece by piece, for text that arrives in chunks, then seals it into a SharedText.
+ */
+class SharedTextBuilder {
+public:
+    SharedTextBuilder(sptr<Ashmem> ashmem, std::size_t capacity);
+    ~SharedTextBuilder();
+
+    /**
+     * Create
+     * @descrition Map a new writable region of capacity bytes, it is sealed by Seal.
+     * @return std::unique_ptr<SharedTextBuilder> the builder, nullptr when the region could not be created.
+     */
+    static std::unique_ptr<SharedTextBuilder> Create(std::size_t capacity);
+
+    /**
+     * Append
+     * @descrition Copy the bytes after those appended so far.
+     * @return bool true on success, false past the capacity or once sealed.
+     */
+    bool Append(const char *data, std::size_t size);
+
+    /**
+     * Seal
+     * @descrition Drop write access and map the appended text read-only, the builder is spent afterwards.
+     * @return std::shared_ptr<const SharedText> the text, nullptr when nothing was appended or sealing failed.
+     */
+    std::shared_ptr<const SharedText> Seal();
+
+    std::size_t GetSize() const;
+
+private:
+    sptr<Ashmem> ashmem_;
+    std::size_t capacity_ = 0;
+    std::size_t size_ = 0;
+};
+} // MiscServices
+} // OHOS
+#endif // PASTE_BOARD_SHARED_TEXT_H
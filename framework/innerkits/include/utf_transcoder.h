@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_UTF_TRANSCODER_H
+#define PASTE_BOARD_UTF_TRANSCODER_H
+
+#include <cstddef>
+#include <string>
+
+namespace OHOS {
+namespace MiscServices {
+/**
+ * Validating UTF-8/UTF-16 conversion for the record codec. Runs of ASCII are converted a vector
+ * at a time with SSE2/AVX2 or NEON when the target has them, everything else goes through a
+ * scalar decoder, so the result does not depend on the backend.
+ */
+class UtfTranscoder {
+public:
+    /**
+     * Utf8ToUtf16
+     * @descrition Convert UTF-8 to UTF-16, replacing the contents of out.
+     * @return bool false and an empty out if the input is not well-formed UTF-8.
+     */
+    static bool Utf8ToUtf16(const std::string &in, std::u16string &out);
+
+    /**
+     * Utf16ToUtf8
+     * @descrition Convert UTF-16 to UTF-8, replacing the contents of out.
+     * @return bool false and an empty out if the input has an unpaired surrogate.
+     */
+    static bool Utf16ToUtf8(const std::u16string &in, std::string &out);
+
+    /**
+     * IsUtf8
+     * @descrition Check text as Utf8ToUtf16 would, without converting it.
+     * @return bool true if the text is well-formed UTF-8.
+     */
+    static bool IsUtf8(const char *data, std::size_t size);
+
+    /**
+     * Utf8Length
+     * @descrition Size of UTF-16 text once converted to UTF-8, without converting it.
+     * @return std::size_t the size in bytes, exact for well-formed input.
+     */
+    static std::size_t Utf8Length(const char16_t *in, std::size_t length);
+
+    /**
+     * GetBackend
+     * @descrition Name of the vector instructions the ASCII path was built with.
+     * @return const char* "avx2", "sse2", "neon" or "scalar".
+     */
+    static const char *GetBackend();
+};
+} // MiscServices
+} // OHOS
+#endif // PASTE_BOARD_UTF_TRANSCODER_H
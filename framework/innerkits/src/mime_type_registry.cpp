@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mime_type_registry.h"
+#include <mutex>
+#include "paste_data_record.h"
+
+namespace OHOS {
+namespace MiscServices {
+MimeTypeRegistry &MimeTypeRegistry::GetInstance()
+{
+    static MimeTypeRegistry instance;
+    return instance;
+}
+
+MimeTypeRegistry::MimeTypeRegistry()
+    : names_ { MIMETYPE_TEXT_HTML, MIMETYPE_TEXT_PLAIN, MIMETYPE_TEXT_URI, MIMETYPE_TEXT_WANT }
+{
+    for (MimeTypeId id = 0; id < names_.size(); id++) {
+        ids_.emplace(names_[id], id);
+    }
+}
+
+MimeTypeId MimeTypeRegistry::Register(const std::string &mimeType)
+{
+    auto id = Find(mimeType);
+    if (id != MIME_ID_INVALID) {
+        return id;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(mimeType);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (ids_.size() >= MIME_ID_MAX) {
+        return MIME_ID_INVALID;
+    }
+    id = static_cast<MimeTypeId>(ids_.size());
+    ids_.emplace(mimeType, id);
+    names_.push_back(mimeType);
+    return id;
+}
+
+MimeTypeId MimeTypeRegistry::Find(const std::string &mimeType) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(mimeType);
+    return it == ids_.end() ? MIME_ID_INVALID : it->second;
+}
+
+const std::string &MimeTypeRegistry::GetName(MimeTypeId id) const
+{
+    static const std::string empty;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id < names_.size() ? names_[id] : empty;
+}
+} // MiscServices
+} // OHOS
@@ -15,9 +15,13 @@
  */
 
 #include "paste_data.h"
+#include <algorithm>
+#include <iterator>
 #include <new>
+#include "content_hash.h"
 #include "paste_data_record.h"
 #include "pasteboard_hilog_wreapper.h"
+#include "record_task_pool.h"
 #include "type_traits"
 
 using namespace std::chrono;
@@ -26,18 +30,48 @@ namespace OHOS {
 namespace MiscServices {
 namespace {
 const std::uint32_t MAX_RECORD_NUM = 128;
+// Lead the V2 and V3 layouts. V1 starts with the record count, which never gets near these values.
+const std::uint32_t PASTE_DATA_V2_MAGIC = 0x50445632;
+const std::uint32_t PASTE_DATA_V3_MAGIC = 0x50445633;
+// not a layout, so every encoded record is decoded for it
+const std::uint32_t PASTE_DATA_WIRE_NONE = 0;
 }
 
 PasteData::PasteData(std::vector<std::shared_ptr<PasteDataRecord>> records)
-    : records_ {std::move(records)}
+    : records_ {std::make_move_iterator(records.begin()), std::make_move_iterator(records.end())}
 {
-    props_.timestamp = steady_clock::now().time_since_epoch().count();
+    RebuildMimeIndex();
+    props_.timestamp = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
     props_.localOnly = false;
 }
 
+PasteData::PasteData(PasteData &&data) : PasteData()
+{
+    *this = std::move(data);
+}
+
+PasteData &PasteData::operator=(PasteData &&data)
+{
+    if (this == &data) {
+        return *this;
+    }
+    props_ = std::move(data.props_);
+    records_ = std::move(data.records_);
+    mimeBitmap_ = data.mimeBitmap_;
+    mimeCounts_ = data.mimeCounts_;
+    firstPos_ = data.firstPos_;
+    frontPos_ = data.frontPos_;
+    // leave the source empty with an index that matches
+    data.records_.clear();
+    data.RebuildMimeIndex();
+    return *this;
+}
+
 PasteDataProperty PasteData::GetProperty()
 {
-    return PasteDataProperty {};
+    PasteDataProperty property = props_;
+    property.mimeTypes = GetMimeTypes();
+    return property;
 }
 
 void PasteData::AddHtmlRecord(const std::string &html)
@@ -45,6 +79,11 @@ void PasteData::AddHtmlRecord(const std::string &html)
     this->AddRecord(PasteDataRecord::NewHtmlRecord(html));
 }
 
+void PasteData::AddHtmlRecord(std::string &&html)
+{
+    this->AddRecord(PasteDataRecord::NewHtmlRecord(std::move(html)));
+}
+
 void PasteData::AddWantRecord(std::shared_ptr<OHOS::AAFwk::Want> want)
 {
     this->AddRecord(PasteDataRecord::NewWantRecord(std::move(want)));
@@ -55,6 +94,11 @@ void PasteData::AddTextRecord(const std::string &text)
     this->AddRecord(PasteDataRecord::NewPlaintTextRecord(text));
 }
 
+void PasteData::AddTextRecord(std::string &&text)
+{
+    this->AddRecord(PasteDataRecord::NewPlaintTextRecord(std::move(text)));
+}
+
 void PasteData::AddUriRecord(const OHOS::Uri &uri)
 {
     this->AddRecord(PasteDataRecord::NewUriRecord(uri));
@@ -65,18 +109,23 @@ void PasteData::AddRecord(std::shared_ptr<PasteDataRecord> record)
     if (record == nullptr) {
         return;
     }
-    records_.insert(records_.begin(), std::move(record));
+    records_.push_front(std::move(record));
+    frontPos_--;
+    IndexFront(records_.front());
     if (records_.size() > MAX_RECORD_NUM) {
-        std::vector<std::shared_ptr<PasteDataRecord>> new_records(records_.begin(), records_.end()-1);
-        this->records_ = new_records;
+        UnindexBack(records_.back());
+        records_.pop_back();
     }
-    RefreshMimeProp();
 }
 
 void PasteData::AddRecord(PasteDataRecord& record)
 {
     this->AddRecord(std::make_shared<PasteDataRecord>(record));
-    RefreshMimeProp();
+}
+
+void PasteData::AddRecord(PasteDataRecord &&record)
+{
+    this->AddRecord(std::make_shared<PasteDataRecord>(std::move(record)));
 }
 
 std::vector<std::string> PasteData::GetMimeTypes()
@@ -90,42 +139,26 @@ std::vector<std::string> PasteData::GetMimeTypes()
 
 std::shared_ptr<std::string> PasteData::GetPrimaryHtml()
 {
-    for (const auto &item: records_) {
-        if (item->GetMimeType() == MIMETYPE_TEXT_HTML) {
-            return item->GetHtmlText();
-        }
-    }
-    return nullptr;
+    auto record = GetFirstRecord(MIME_ID_TEXT_HTML);
+    return record == nullptr ? nullptr : record->GetHtmlText();
 }
 
 std::shared_ptr<OHOS::AAFwk::Want> PasteData::GetPrimaryWant()
 {
-    for (const auto &item: records_) {
-        if (item->GetMimeType() == MIMETYPE_TEXT_WANT) {
-            return item->GetWant();
-        }
-    }
-    return nullptr;
+    auto record = GetFirstRecord(MIME_ID_TEXT_WANT);
+    return record == nullptr ? nullptr : record->GetWant();
 }
 
 std::shared_ptr<std::string> PasteData::GetPrimaryText()
 {
-    for (const auto &item: records_) {
-        if (item->GetMimeType() == MIMETYPE_TEXT_PLAIN) {
-            return item->GetPlainText();
-        }
-    }
-    return nullptr;
+    auto record = GetFirstRecord(MIME_ID_TEXT_PLAIN);
+    return record == nullptr ? nullptr : record->GetPlainText();
 }
 
 std::shared_ptr<OHOS::Uri> PasteData::GetPrimaryUri()
 {
-    for (const auto &item : records_) {
-        if (item->GetMimeType() == MIMETYPE_TEXT_URI) {
-            return item->GetUri();
-        }
-    }
-    return nullptr;
+    auto record = GetFirstRecord(MIME_ID_TEXT_URI);
+    return record == nullptr ? nullptr : record->GetUri();
 }
 
 std::shared_ptr<std::string> PasteData::GetPrimaryMimeType()
@@ -140,12 +173,34 @@ std::shared_ptr<std::string> PasteData::GetPrimaryMimeType()
 std::shared_ptr<PasteDataRecord> PasteData::GetRecordAt(std::size_t index)
 {
     if (records_.size() > index) {
-        return records_[index];
+        return Materialize(index);
     } else {
         return nullptr;
     }
 }
 
+std::shared_ptr<PasteDataRecord> PasteData::PeekRecordAt(std::size_t index) const
+{
+    return (index < records_.size()) ? records_[index] : nullptr;
+}
+
+std::shared_ptr<PasteDataRecord> PasteData::PeekFirstRecord(const std::string &mimeType) const
+{
+    auto id = MimeTypeRegistry::GetInstance().Find(mimeType);
+    if (id < MIME_ID_BUILTIN_COUNT) {
+        if ((mimeBitmap_ & (1ULL << id)) == 0) {
+            return nullptr;
+        }
+        return records_[static_cast<std::size_t>(firstPos_[id] - frontPos_)];
+    }
+    for (const auto &item : records_) {
+        if (item != nullptr && item->GetMimeType() == mimeType) {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
 std::size_t PasteData::GetRecordCount()
 {
     return records_.size();
@@ -154,8 +209,8 @@ std::size_t PasteData::GetRecordCount()
 bool PasteData::RemoveRecordAt(std::size_t number)
 {
     if (records_.size() > number) {
-        records_.emplace(records_.begin() + static_cast<std::int64_t>(number));
-        RefreshMimeProp();
+        records_.erase(records_.begin() + static_cast<std::ptrdiff_t>(number));
+        RebuildMimeIndex();
         return true;
     } else {
         return false;
@@ -166,7 +221,7 @@ bool PasteData::ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRec
 {
     if (records_.size() > number) {
         records_[number] = std::move(record);
-        RefreshMimeProp();
+        RebuildMimeIndex();
         return true;
     } else {
         return false;
@@ -175,8 +230,13 @@ bool PasteData::ReplaceRecordAt(std::size_t number, std::shared_ptr<PasteDataRec
 
 bool PasteData::HasMimeType(const std::string &mimeType)
 {
-    for (auto &item : records_) {
-        if (item->GetMimeType() == mimeType) {
+    auto id = MimeTypeRegistry::GetInstance().Find(mimeType);
+    if (id != MIME_ID_INVALID) {
+        return (mimeBitmap_ & (1ULL << id)) != 0;
+    }
+    // types past the registry capacity are not indexed
+    for (const auto &item : records_) {
+        if (item != nullptr && item->GetMimeType() == mimeType) {
             return true;
         }
     }
@@ -190,32 +250,171 @@ std::string PasteData::GetTag()
 
 std::vector<std::shared_ptr<PasteDataRecord>> PasteData::AllRecords() const
 {
-    return this->records_;
+    return DecodeRecords(PASTE_DATA_WIRE_NONE);
 }
 
-void PasteData::RefreshMimeProp()
+uint64_t PasteData::GetFingerprint()
 {
-    std::vector<std::string> mimeTypes;
-    for (const auto record : records_) {
-        if (record == nullptr) {
+    auto decoded = DecodeRecords(PASTE_DATA_WIRE_NONE);
+    std::vector<uint64_t> fingerprints;
+    fingerprints.reserve(records_.size());
+    for (std::size_t i = 0; i < records_.size(); i++) {
+        // as Materialize, a record that fails to decode stays encoded, without a fingerprint
+        if (decoded[i] != nullptr) {
+            records_[i] = std::move(decoded[i]);
+        }
+        fingerprints.push_back((records_[i] != nullptr) ? records_[i]->GetFingerprint() : 0);
+    }
+    return ContentHash::Hash64(fingerprints.data(), fingerprints.size() * sizeof(uint64_t));
+}
+
+uint64_t PasteData::GetContentSize() const
+{
+    uint64_t size = 0;
+    for (const auto &record : records_) {
+        size += (record != nullptr) ? record->GetContentSize() : 0;
+    }
+    return size;
+}
+
+void PasteData::IndexFront(const std::shared_ptr<PasteDataRecord> &record)
+{
+    if (record == nullptr || record->GetMimeTypeId() >= MIME_ID_MAX) {
+        return;
+    }
+    auto id = record->GetMimeTypeId();
+    mimeBitmap_ |= (1ULL << id);
+    mimeCounts_[id]++;
+    if (id < MIME_ID_BUILTIN_COUNT) {
+        firstPos_[id] = frontPos_;
+    }
+}
+
+void PasteData::IndexBack(const std::shared_ptr<PasteDataRecord> &record)
+{
+    if (record == nullptr || record->GetMimeTypeId() >= MIME_ID_MAX) {
+        return;
+    }
+    auto id = record->GetMimeTypeId();
+    if (id < MIME_ID_BUILTIN_COUNT && mimeCounts_[id] == 0) {
+        firstPos_[id] = frontPos_ + static_cast<std::int64_t>(records_.size()) - 1;
+    }
+    mimeBitmap_ |= (1ULL << id);
+    mimeCounts_[id]++;
+}
+
+void PasteData::UnindexBack(const std::shared_ptr<PasteDataRecord> &record)
+{
+    if (record == nullptr || record->GetMimeTypeId() >= MIME_ID_MAX) {
+        return;
+    }
+    // the last record is only the first of its type when it is the only one, so firstPos_ stays valid
+    auto id = record->GetMimeTypeId();
+    if (--mimeCounts_[id] == 0) {
+        mimeBitmap_ &= ~(1ULL << id);
+    }
+}
+
+void PasteData::RebuildMimeIndex()
+{
+    mimeBitmap_ = 0;
+    mimeCounts_.fill(0);
+    frontPos_ = 0;
+    std::size_t size = records_.size();
+    for (std::size_t i = 0; i < size; i++) {
+        auto &record = records_[i];
+        if (record == nullptr || record->GetMimeTypeId() >= MIME_ID_MAX) {
             continue;
         }
-        mimeTypes.insert(mimeTypes.end(), record->GetMimeType());
+        auto id = record->GetMimeTypeId();
+        if (id < MIME_ID_BUILTIN_COUNT && mimeCounts_[id] == 0) {
+            firstPos_[id] = static_cast<std::int64_t>(i);
+        }
+        mimeBitmap_ |= (1ULL << id);
+        mimeCounts_[id]++;
     }
-    props_.mimeTypes = mimeTypes;
+}
+
+std::shared_ptr<PasteDataRecord> PasteData::GetFirstRecord(MimeTypeId id)
+{
+    if ((mimeBitmap_ & (1ULL << id)) == 0) {
+        return nullptr;
+    }
+    return Materialize(static_cast<std::size_t>(firstPos_[id] - frontPos_));
+}
+
+const std::shared_ptr<PasteDataRecord> &PasteData::Materialize(std::size_t index)
+{
+    auto &record = records_[index];
+    if (record != nullptr && record->IsEncoded()) {
+        // the decoded record has the same mime type, the index stays as it is
+        auto decoded = record->Decode();
+        if (decoded != nullptr) {
+            record = std::move(decoded);
+        } else {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "decode record %{public}zu failed.", index);
+        }
+    }
+    return record;
+}
+
+std::size_t PasteData::SerializedSize(uint32_t version) const
+{
+    if (version >= PASTE_DATA_WIRE_V2) {
+        // magic and count, then the present records without flags
+        std::size_t size = sizeof(uint32_t) + sizeof(uint32_t);
+        for (const auto &item : records_) {
+            if (item != nullptr) {
+                size += item->SerializedSize(version);
+            }
+        }
+        return size;
+    }
+    // record count, then a presence flag and the record itself for each record
+    std::size_t size = sizeof(uint32_t);
+    for (const auto &item : records_) {
+        size += sizeof(int32_t);
+        if (item != nullptr) {
+            size += item->SerializedSize(version);
+        }
+    }
+    return size;
 }
 
 bool PasteData::Marshalling(Parcel &parcel) const
 {
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    return Marshalling(parcel, PASTE_DATA_WIRE_V1);
+}
+
+bool PasteData::Marshalling(Parcel &parcel, uint32_t version) const
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start, version %{public}u.", version);
     auto length = records_.size();
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "length: %{public}zu.", length);
+    // Size the whole clip first: an oversized clip fails before any text is converted, and the parcel
+    // buffer is grown once instead of reallocating record by record.
+    std::size_t required = parcel.GetDataSize() + SerializedSize(version);
+    if (required > parcel.GetMaxCapacity()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "too large: %{public}zu, max %{public}zu.", required,
+            parcel.GetMaxCapacity());
+        return false;
+    }
+    if (required > parcel.GetDataCapacity() && !parcel.SetDataCapacity(required)) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "reserve %{public}zu failed.", required);
+    }
+    if (version >= PASTE_DATA_WIRE_V2) {
+        return MarshallingUtf8(parcel, version);
+    }
+    // only the UTF-16 layout transcodes, the UTF-8 one is a copy and gains nothing from more threads
+    if (RecordTaskPool::GetInstance().ShouldSplit(length, required - parcel.GetDataSize())) {
+        return MarshallingParallel(parcel);
+    }
     // write length
     if (!parcel.WriteUint32(static_cast<uint32_t>(length))) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
         return false;
     }
-    for (const auto item : records_) {
+    for (const auto &item : records_) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "for.");
         if (!parcel.WriteParcelable(item.get())) {
             PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed end.");
@@ -226,33 +425,166 @@ bool PasteData::Marshalling(Parcel &parcel) const
     return true;
 }
 
-bool PasteData::ReadFromParcel(Parcel &parcel)
+bool PasteData::MarshallingParallel(Parcel &parcel) const
+{
+    // every record is coded into a parcel of its own, then the parts are appended in order
+    std::size_t length = records_.size();
+    std::vector<std::unique_ptr<Parcel>> parts(length);
+    std::vector<char> written(length, 0);
+    RecordTaskPool::GetInstance().ParallelFor(length, [this, &parts, &written](std::size_t i) {
+        auto part = std::make_unique<Parcel>();
+        const auto &record = records_[i];
+        std::size_t size = sizeof(int32_t) + ((record != nullptr) ? record->SerializedSize(PASTE_DATA_WIRE_V1) : 0);
+        if (size > part->GetMaxCapacity()) {
+            part->SetMaxCapacity(size);
+        }
+        part->SetDataCapacity(size);
+        written[i] = part->WriteParcelable(record.get()) ? 1 : 0;
+        parts[i] = std::move(part);
+    });
+    if (!parcel.WriteUint32(static_cast<uint32_t>(length))) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+        return false;
+    }
+    for (std::size_t i = 0; i < length; i++) {
+        // parts are whole parcel words, appending adds no padding
+        if (!written[i] || !parcel.WriteBuffer(reinterpret_cast<const void *>(parts[i]->GetData()),
+            parts[i]->GetDataSize())) {
+            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed end.");
+            return false;
+        }
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return true;
+}
+
+bool PasteData::MarshallingUtf8(Parcel &parcel, uint32_t version) const
+{
+    uint32_t count = 0;
+    for (const auto &item : records_) {
+        count += (item != nullptr) ? 1 : 0;
+    }
+    uint32_t magic = (version >= PASTE_DATA_WIRE_V3) ? PASTE_DATA_V3_MAGIC : PASTE_DATA_V2_MAGIC;
+    if (!parcel.WriteUint32(magic) || !parcel.WriteUint32(count)) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write header failed.");
+        return false;
+    }
+    // Records kept in another layout, such as a clip a V1 peer set, are transcoded up front, side by side
+    // for a large clip. Writing them is then a copy, and the records held here stay encoded.
+    auto records = DecodeRecords(version);
+    for (std::size_t i = 0; i < records.size(); i++) {
+        if (records_[i] != nullptr && (records[i] == nullptr || !records[i]->Marshalling(parcel, version))) {
+            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed end.");
+            return false;
+        }
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return true;
+}
+
+bool PasteData::ReadFromParcel(Parcel &parcel, bool lazy)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
     records_.clear();
-    // read vector length
+    RebuildMimeIndex();
+    // read vector length, or the magic of the V2 and V3 layouts
     auto length = parcel.ReadUint32();
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "length: %{public}u.", length);
+    uint32_t version = PASTE_DATA_WIRE_V1;
+    if (length == PASTE_DATA_V2_MAGIC || length == PASTE_DATA_V3_MAGIC) {
+        version = (length == PASTE_DATA_V3_MAGIC) ? PASTE_DATA_WIRE_V3 : PASTE_DATA_WIRE_V2;
+        if (!parcel.ReadUint32(length)) {
+            return false;
+        }
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "length: %{public}u, version %{public}u.", length, version);
+    // A large UTF-16 clip is walked like a lazy one, then its records are transcoded in parallel.
+    bool split = !lazy && version < PASTE_DATA_WIRE_V2 &&
+        RecordTaskPool::GetInstance().ShouldSplit(length, parcel.GetReadableBytes());
+    lazy = lazy || split;
+    // lazy records point into one copy of the record bytes, taken once they were all walked
+    auto buffer = lazy ? std::make_shared<std::vector<uint8_t>>() : nullptr;
+    std::size_t base = parcel.GetReadPosition();
+    bool anyEncoded = false;
     for (uint32_t i = 0; i < length; i++) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "for.");
-        std::unique_ptr<PasteDataRecord> record(parcel.ReadParcelable<PasteDataRecord>());
-        if (!record) {
+        // V1 writes each record as a parcelable, with a presence flag
+        if (version < PASTE_DATA_WIRE_V2 && parcel.ReadInt32() == 0) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "nullptr.");
             continue;
         }
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "add.");
-        AddRecord(*record);
+        auto record = lazy ? PasteDataRecord::ReadEncoded(parcel, version, buffer, base) :
+            std::shared_ptr<PasteDataRecord>(PasteDataRecord::Unmarshalling(parcel, version));
+        if (record == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read record %{public}u failed.", i);
+            // V2 records are not framed, a broken one leaves no way to find the next
+            if (version >= PASTE_DATA_WIRE_V2) {
+                return false;
+            }
+            continue;
+        }
+        if (records_.size() >= MAX_RECORD_NUM) {
+            continue;
+        }
+        anyEncoded = anyEncoded || record->IsEncoded();
+        // records were written newest first, append to keep that order
+        records_.push_back(std::move(record));
+        IndexBack(records_.back());
+    }
+    if (anyEncoded) {
+        auto data = reinterpret_cast<const uint8_t *>(parcel.GetData());
+        buffer->assign(data + base, data + parcel.GetReadPosition());
+    }
+    if (split) {
+        // a record that fails to decode is dropped, as the serial read does
+        auto decoded = DecodeRecords(PASTE_DATA_WIRE_NONE);
+        records_.assign(decoded.begin(), decoded.end());
+        if (std::find(records_.begin(), records_.end(), nullptr) != records_.end()) {
+            records_.erase(std::remove(records_.begin(), records_.end(), nullptr), records_.end());
+            RebuildMimeIndex();
+        }
     }
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
     return true;
 }
 
+// The records as they are, with every one kept encoded in another layout than version decoded into a copy,
+// nullptr where that fails. A large clip is decoded on the worker pool.
+std::vector<std::shared_ptr<PasteDataRecord>> PasteData::DecodeRecords(uint32_t version) const
+{
+    std::vector<std::shared_ptr<PasteDataRecord>> records(records_.begin(), records_.end());
+    std::vector<std::size_t> pending;
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < records.size(); i++) {
+        std::size_t size = (records[i] != nullptr) ? records[i]->GetDecodeSize(version) : 0;
+        if (size != 0) {
+            pending.push_back(i);
+            bytes += size;
+        }
+    }
+    auto decode = [&records, &pending](std::size_t i) {
+        auto &record = records[pending[i]];
+        record = record->Decode();
+    };
+    if (RecordTaskPool::GetInstance().ShouldSplit(pending.size(), bytes)) {
+        RecordTaskPool::GetInstance().ParallelFor(pending.size(), decode);
+    } else {
+        for (std::size_t i = 0; i < pending.size(); i++) {
+            decode(i);
+        }
+    }
+    return records;
+}
+
 PasteData *PasteData::Unmarshalling(Parcel &parcel)
+{
+    return Unmarshalling(parcel, false);
+}
+
+PasteData *PasteData::Unmarshalling(Parcel &parcel, bool lazy)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
     PasteData *pasteData = new PasteData();
 
-    if (pasteData && !pasteData->ReadFromParcel(parcel)) {
+    if (pasteData && !pasteData->ReadFromParcel(parcel, lazy)) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "delete end.");
         delete pasteData;
         pasteData = nullptr;
@@ -13,23 +13,517 @@
  * limitations under the License.
  */
 #include "paste_data_record.h"
+#include <array>
+#include <new>
+#include <string_view>
+#include <utility>
+#include "content_hash.h"
 #include "pasteboard_common.h"
+#include "shared_text.h"
+#include "utf_transcoder.h"
 
 namespace OHOS {
 namespace MiscServices {
 namespace {
-constexpr int MAX_TEXT_LEN = 500 * 1024;
+constexpr std::size_t MAX_TEXT_LEN = PasteDataRecord::MAX_TEXT_SIZE;
+constexpr std::size_t PARCEL_WORD_SIZE = sizeof(int32_t);
+// Want carries parameters that are only known once written, reserve a typical size for it.
+constexpr std::size_t WANT_SIZE_HINT = 1024;
+// V3 text from this size on goes in shared memory, the size where MessageParcel switches raw data to ashmem
+constexpr std::size_t SHARED_TEXT_MIN_SIZE = SharedText::MIN_SIZE;
+// stands for the length of inline text when a V3 record carries its text in shared memory
+constexpr uint32_t SHARED_TEXT_MARKER = 0xFFFFFFFF;
+// marker, size and the flat binder object holding the file descriptor
+constexpr std::size_t SHARED_TEXT_SIZE = 3 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+
+std::size_t AlignParcel(std::size_t size)
+{
+    return (size + PARCEL_WORD_SIZE - 1) & ~(PARCEL_WORD_SIZE - 1);
+}
+
+// Size of WriteString16(ToUtf16(str)): every UTF-8 lead byte becomes one UTF-16 unit, 4-byte leads two.
+std::size_t String16Size(std::string_view str)
+{
+    std::size_t units = 0;
+    for (unsigned char c : str) {
+        if ((c & 0xC0) != 0x80) {
+            units += ((c & 0xF8) == 0xF0) ? 2 : 1;
+        }
+    }
+    return PARCEL_WORD_SIZE + AlignParcel((units + 1) * sizeof(char16_t));
+}
+
+// Ill-formed text converts to an empty string, as string_ex does.
+std::u16string ToUtf16(const std::string &str)
+{
+    std::u16string result;
+    UtfTranscoder::Utf8ToUtf16(str, result);
+    return result;
 }
+
+std::string ToUtf8(const std::u16string &str)
+{
+    std::string result;
+    UtfTranscoder::Utf16ToUtf8(str, result);
+    return result;
+}
+
+std::size_t Utf8Size(std::string_view str)
+{
+    return PARCEL_WORD_SIZE + AlignParcel(str.size());
+}
+
+bool WriteUtf8(Parcel &parcel, std::string_view str)
+{
+    return parcel.WriteUint32(static_cast<uint32_t>(str.size())) && parcel.WriteBuffer(str.data(), str.size());
+}
+
+// The view points into the parcel, valid until it is changed.
+bool ReadUtf8(Parcel &parcel, uint32_t length, std::string_view &str)
+{
+    auto buffer = parcel.ReadBuffer(length);
+    if (buffer == nullptr && length != 0) {
+        return false;
+    }
+    str = std::string_view(reinterpret_cast<const char *>(buffer), length);
+    return true;
+}
+
+bool ReadUtf8(Parcel &parcel, uint32_t length, std::string &str)
+{
+    std::string_view view;
+    if (!ReadUtf8(parcel, length, view)) {
+        return false;
+    }
+    str.assign(view.data(), view.size());
+    return true;
+}
+
+bool ReadUtf8(Parcel &parcel, std::string &str)
+{
+    uint32_t length = 0;
+    return parcel.ReadUint32(length) && ReadUtf8(parcel, length, str);
+}
+
+// What the factories let a text record hold: well-formed UTF-8 below the size cap. Decoded text is held to the
+// same, so every peer gets the same text whatever layout it reads.
+bool IsValidText(std::string_view text)
+{
+    return text.size() < MAX_TEXT_LEN && UtfTranscoder::IsUtf8(text.data(), text.size());
+}
+
+// Text in shared memory cannot be skipped, its file descriptor has to be taken out of the parcel.
+bool SkipText(Parcel &parcel, uint32_t version, std::size_t &size)
+{
+    if (version >= PASTE_DATA_WIRE_V2) {
+        uint32_t length = 0;
+        if (!parcel.ReadUint32(length) || length == SHARED_TEXT_MARKER || !parcel.SkipBytes(length)) {
+            return false;
+        }
+        size = length;
+        return true;
+    }
+    int32_t length = 0;
+    if (!parcel.ReadInt32(length)) {
+        return false;
+    }
+    // a null string16 is only its -1 length
+    size = 0;
+    if (length < 0) {
+        return true;
+    }
+    auto units = parcel.ReadBuffer((static_cast<std::size_t>(length) + 1) * sizeof(char16_t));
+    if (units == nullptr) {
+        return false;
+    }
+    size = UtfTranscoder::Utf8Length(reinterpret_cast<const char16_t *>(units), static_cast<std::size_t>(length));
+    return true;
+}
+} // namespace
+
+/**
+ * Encode, decode, skip, size, hash and text conversion of one builtin record type. Records dispatch on their
+ * interned mime type id through a table built from these, so supporting another builtin type takes
+ * an id in mime_type_registry.h, a payload alternative and a specialization here. LAZY types can be
+ * skipped in a parcel without decoding and so left encoded until used.
+ */
+template<MimeTypeId id>
+struct RecordCodec;
+
+// html and plain text differ only in which payload alternative they hold
+template<std::size_t index>
+struct TextRecordCodec {
+    static constexpr std::size_t PAYLOAD = index;
+    static constexpr bool LAZY = true;
+
+    static const std::string *Get(const PasteDataRecord &record)
+    {
+        auto text = std::get_if<index>(&record.payload_);
+        return (text != nullptr) ? text->get() : nullptr;
+    }
+
+    static const SharedText *GetShared(const PasteDataRecord &record)
+    {
+        auto text = std::get_if<PasteDataRecord::PAYLOAD_SHARED>(&record.payload_);
+        return (text != nullptr) ? text->get() : nullptr;
+    }
+
+    // the text in the string, the record or the shared region holding it, false when the record has none
+    static bool View(const PasteDataRecord &record, std::string_view &view)
+    {
+        if (auto text = Get(record); text != nullptr) {
+            view = *text;
+            return true;
+        }
+        if (auto text = std::get_if<PasteDataRecord::PAYLOAD_INLINE>(&record.payload_); text != nullptr) {
+            view = text->View();
+            return true;
+        }
+        if (auto shared = GetShared(record); shared != nullptr) {
+            view = std::string_view(shared->GetData(), shared->GetSize());
+            return true;
+        }
+        return false;
+    }
+
+    static bool IsShared(const PasteDataRecord &record, uint32_t version)
+    {
+        std::string_view text;
+        return version >= PASTE_DATA_WIRE_V3 && View(record, text) &&
+            (GetShared(record) != nullptr || text.size() >= SHARED_TEXT_MIN_SIZE);
+    }
+
+    static std::size_t Size(const PasteDataRecord &record, uint32_t version)
+    {
+        std::string_view text;
+        if (!View(record, text)) {
+            return 0;
+        }
+        if (IsShared(record, version)) {
+            return SHARED_TEXT_SIZE;
+        }
+        return (version >= PASTE_DATA_WIRE_V2) ? Utf8Size(text) : String16Size(text);
+    }
+
+    static bool Encode(const PasteDataRecord &record, Parcel &parcel, uint32_t version)
+    {
+        std::string_view text;
+        if (!View(record, text)) {
+            // V1 always tolerated a record without its text
+            return version < PASTE_DATA_WIRE_V2;
+        }
+        if (IsShared(record, version)) {
+            // a region that came in is passed on as it is, every reader maps the same pages
+            std::shared_ptr<const SharedText> created;
+            auto shared = GetShared(record);
+            if (shared == nullptr) {
+                created = SharedText::Create(text.data(), text.size());
+                shared = created.get();
+            }
+            if (shared != nullptr) {
+                return parcel.WriteUint32(SHARED_TEXT_MARKER) && shared->Marshalling(parcel);
+            }
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "no shared memory, %{public}zu bytes inline.", text.size());
+        }
+        if (version >= PASTE_DATA_WIRE_V2) {
+            return WriteUtf8(parcel, text);
+        }
+        return parcel.WriteString16(ToUtf16(std::string(text)));
+    }
+
+    static bool Decode(PasteDataRecord &record, Parcel &parcel, uint32_t version)
+    {
+        if (version >= PASTE_DATA_WIRE_V2) {
+            uint32_t length = 0;
+            if (!parcel.ReadUint32(length)) {
+                return false;
+            }
+            if (version >= PASTE_DATA_WIRE_V3 && length == SHARED_TEXT_MARKER) {
+                auto shared = SharedText::Unmarshalling(parcel);
+                if (shared == nullptr || !IsValidText(std::string_view(shared->GetData(), shared->GetSize()))) {
+                    return false;
+                }
+                record.payload_.template emplace<PasteDataRecord::PAYLOAD_SHARED>(std::move(shared));
+                return true;
+            }
+            std::string_view view;
+            if (!ReadUtf8(parcel, length, view) || !IsValidText(view)) {
+                return false;
+            }
+            if (!record.EmplaceInline(view)) {
+                record.payload_.template emplace<index>(std::make_shared<std::string>(view));
+            }
+            return true;
+        }
+        // ill-formed UTF-16 converts to an empty string, as string_ex does
+        std::string text = ToUtf8(parcel.ReadString16());
+        if (text.size() >= MAX_TEXT_LEN) {
+            return false;
+        }
+        if (!record.EmplaceInline(text)) {
+            record.payload_.template emplace<index>(std::make_shared<std::string>(std::move(text)));
+        }
+        return true;
+    }
+
+    static bool Skip(Parcel &parcel, uint32_t version, std::size_t &contentSize)
+    {
+        if (version < PASTE_DATA_WIRE_V2) {
+            return SkipText(parcel, version, contentSize) && contentSize < MAX_TEXT_LEN;
+        }
+        // the bytes skipped are passed on as they are, so they are checked as Decode checks them
+        uint32_t length = 0;
+        std::string_view text;
+        if (!parcel.ReadUint32(length) || length == SHARED_TEXT_MARKER || !ReadUtf8(parcel, length, text) ||
+            !IsValidText(text)) {
+            return false;
+        }
+        contentSize = text.size();
+        return true;
+    }
+
+    static std::string ToText(const PasteDataRecord &record)
+    {
+        std::string_view text;
+        return View(record, text) ? std::string(text) : "";
+    }
+
+    static std::size_t ContentSize(const PasteDataRecord &record)
+    {
+        std::string_view text;
+        return View(record, text) ? text.size() : 0;
+    }
+
+    static uint64_t Hash(const PasteDataRecord &record, uint64_t seed)
+    {
+        std::string_view text;
+        return View(record, text) ? ContentHash::Hash64(text.data(), text.size(), seed) : seed;
+    }
+};
+
+template<>
+struct RecordCodec<MIME_ID_TEXT_HTML> : TextRecordCodec<PasteDataRecord::PAYLOAD_HTML> {};
+
+template<>
+struct RecordCodec<MIME_ID_TEXT_PLAIN> : TextRecordCodec<PasteDataRecord::PAYLOAD_PLAIN> {};
+
+template<>
+struct RecordCodec<MIME_ID_TEXT_URI> {
+    static constexpr std::size_t PAYLOAD = PasteDataRecord::PAYLOAD_URI;
+    static constexpr bool LAZY = true;
+
+    static const OHOS::Uri *Get(const PasteDataRecord &record)
+    {
+        auto uri = std::get_if<PAYLOAD>(&record.payload_);
+        return (uri != nullptr) ? uri->get() : nullptr;
+    }
+
+    // the uri as text, false when the record has none
+    static bool GetText(const PasteDataRecord &record, std::string &text)
+    {
+        if (auto uri = Get(record); uri != nullptr) {
+            text = uri->ToString();
+            return true;
+        }
+        if (auto inlined = std::get_if<PasteDataRecord::PAYLOAD_INLINE>(&record.payload_); inlined != nullptr) {
+            text.assign(inlined->View().data(), inlined->View().size());
+            return true;
+        }
+        return false;
+    }
+
+    static std::size_t Size(const PasteDataRecord &record, uint32_t version)
+    {
+        std::string text;
+        if (!GetText(record, text)) {
+            return 0;
+        }
+        // V1 writes the Uri parcelable: presence flag and the string
+        return (version >= PASTE_DATA_WIRE_V2) ? Utf8Size(text) : PARCEL_WORD_SIZE + String16Size(text);
+    }
+
+    static bool Encode(const PasteDataRecord &record, Parcel &parcel, uint32_t version)
+    {
+        std::string text;
+        if (!GetText(record, text)) {
+            return version < PASTE_DATA_WIRE_V2;
+        }
+        if (version >= PASTE_DATA_WIRE_V2) {
+            return WriteUtf8(parcel, text);
+        }
+        if (auto uri = Get(record); uri != nullptr) {
+            return parcel.WriteParcelable(uri);
+        }
+        OHOS::Uri uri(text);
+        return parcel.WriteParcelable(&uri);
+    }
+
+    static bool Decode(PasteDataRecord &record, Parcel &parcel, uint32_t version)
+    {
+        if (version >= PASTE_DATA_WIRE_V2) {
+            uint32_t length = 0;
+            std::string_view text;
+            if (!parcel.ReadUint32(length) || !ReadUtf8(parcel, length, text)) {
+                return false;
+            }
+            if (!record.EmplaceInline(text)) {
+                record.payload_.emplace<PAYLOAD>(std::make_shared<OHOS::Uri>(std::string(text)));
+            }
+            return true;
+        }
+        std::unique_ptr<OHOS::Uri> uri(parcel.ReadParcelable<OHOS::Uri>());
+        if (!uri) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "nullptr.");
+            return false;
+        }
+        record.payload_.emplace<PAYLOAD>(std::move(uri));
+        return true;
+    }
+
+    static bool Skip(Parcel &parcel, uint32_t version, std::size_t &contentSize)
+    {
+        // V1 has the presence flag of the Uri parcelable first, a missing uri fails to decode
+        return (version >= PASTE_DATA_WIRE_V2 || parcel.ReadInt32() != 0) && SkipText(parcel, version, contentSize);
+    }
+
+    static std::string ToText(const PasteDataRecord &record)
+    {
+        std::string text;
+        GetText(record, text);
+        return text;
+    }
+
+    static std::size_t ContentSize(const PasteDataRecord &record)
+    {
+        return ToText(record).size();
+    }
+
+    static uint64_t Hash(const PasteDataRecord &record, uint64_t seed)
+    {
+        std::string text = ToText(record);
+        return ContentHash::Hash64(text.data(), text.size(), seed);
+    }
+};
+
+template<>
+struct RecordCodec<MIME_ID_TEXT_WANT> {
+    static constexpr std::size_t PAYLOAD = PasteDataRecord::PAYLOAD_WANT;
+    // a want has no length prefix to skip by
+    static constexpr bool LAZY = false;
+
+    static const OHOS::AAFwk::Want *Get(const PasteDataRecord &record)
+    {
+        auto want = std::get_if<PAYLOAD>(&record.payload_);
+        return (want != nullptr) ? want->get() : nullptr;
+    }
+
+    static std::size_t Size(const PasteDataRecord &record, uint32_t version)
+    {
+        return (Get(record) != nullptr) ? PARCEL_WORD_SIZE + WANT_SIZE_HINT : 0;
+    }
+
+    static bool Encode(const PasteDataRecord &record, Parcel &parcel, uint32_t version)
+    {
+        auto want = Get(record);
+        if (want == nullptr) {
+            return version < PASTE_DATA_WIRE_V2;
+        }
+        return parcel.WriteParcelable(want);
+    }
+
+    static bool Decode(PasteDataRecord &record, Parcel &parcel, uint32_t version)
+    {
+        std::unique_ptr<OHOS::AAFwk::Want> want(parcel.ReadParcelable<OHOS::AAFwk::Want>());
+        if (!want) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "nullptr.");
+            return false;
+        }
+        record.payload_.emplace<PAYLOAD>(std::move(want));
+        return true;
+    }
+
+    static bool Skip(Parcel &parcel, uint32_t version, std::size_t &contentSize)
+    {
+        return false;
+    }
+
+    static std::string ToText(const PasteDataRecord &record)
+    {
+        return "";
+    }
+
+    static std::size_t ContentSize(const PasteDataRecord &record)
+    {
+        auto want = Get(record);
+        return (want != nullptr) ? want->ToUri().size() : 0;
+    }
+
+    static uint64_t Hash(const PasteDataRecord &record, uint64_t seed)
+    {
+        auto want = Get(record);
+        if (want == nullptr) {
+            return seed;
+        }
+        std::string text = want->ToUri();
+        return ContentHash::Hash64(text.data(), text.size(), seed);
+    }
+};
+
+namespace {
+struct RecordCodecOps {
+    std::size_t (*size)(const PasteDataRecord &record, uint32_t version);
+    bool (*encode)(const PasteDataRecord &record, Parcel &parcel, uint32_t version);
+    bool (*decode)(PasteDataRecord &record, Parcel &parcel, uint32_t version);
+    std::string (*toText)(const PasteDataRecord &record);
+    bool (*skip)(Parcel &parcel, uint32_t version, std::size_t &contentSize);
+    uint64_t (*hash)(const PasteDataRecord &record, uint64_t seed);
+    std::size_t (*contentSize)(const PasteDataRecord &record);
+    std::size_t payload;
+    bool lazy;
+};
+
+template<MimeTypeId... ids>
+constexpr std::array<RecordCodecOps, MIME_ID_BUILTIN_COUNT> MakeCodecTable(std::integer_sequence<MimeTypeId, ids...>)
+{
+    return { { { &RecordCodec<ids>::Size, &RecordCodec<ids>::Encode, &RecordCodec<ids>::Decode,
+        &RecordCodec<ids>::ToText, &RecordCodec<ids>::Skip, &RecordCodec<ids>::Hash,
+        &RecordCodec<ids>::ContentSize, RecordCodec<ids>::PAYLOAD, RecordCodec<ids>::LAZY }... } };
+}
+
+constexpr std::array<RecordCodecOps, MIME_ID_BUILTIN_COUNT> CODEC_TABLE =
+    MakeCodecTable(std::make_integer_sequence<MimeTypeId, MIME_ID_BUILTIN_COUNT> {});
+
+const RecordCodecOps *GetCodec(MimeTypeId id)
+{
+    return (id < MIME_ID_BUILTIN_COUNT) ? &CODEC_TABLE[id] : nullptr;
+}
+
+// A record of another type holds one of the builtin payloads, it converts like the type owning that payload.
+const RecordCodecOps *GetPayloadCodec(std::size_t payload)
+{
+    for (const auto &codec : CODEC_TABLE) {
+        if (codec.payload == payload) {
+            return &codec;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
 std::shared_ptr<PasteDataRecord> PasteDataRecord::NewHtmlRecord(const std::string &htmlText)
 {
     if (htmlText.length() >= MAX_TEXT_LEN) {
         return nullptr;
     }
-    return std::make_shared<PasteDataRecord>(MIMETYPE_TEXT_HTML,
-                                             std::make_shared<std::string>(htmlText),
-                                             nullptr,
-                                             nullptr,
-                                             nullptr);
+    return NewHtmlRecord(std::string(htmlText));
+}
+
+std::shared_ptr<PasteDataRecord> PasteDataRecord::NewHtmlRecord(std::string &&htmlText)
+{
+    if (htmlText.length() >= MAX_TEXT_LEN) {
+        return nullptr;
+    }
+    return NewTextRecord(MIME_ID_TEXT_HTML, std::move(htmlText));
 }
 
 std::shared_ptr<PasteDataRecord> PasteDataRecord::NewWantRecord(std::shared_ptr<OHOS::AAFwk::Want> want)
@@ -46,20 +540,68 @@ std::shared_ptr<PasteDataRecord> PasteDataRecord::NewPlaintTextRecord(const std:
     if (text.length() >= MAX_TEXT_LEN) {
         return nullptr;
     }
-    return std::make_shared<PasteDataRecord>(MIMETYPE_TEXT_PLAIN,
-                                             nullptr,
-                                             nullptr,
-                                             std::make_shared<std::string>(text),
-                                             nullptr);
+    return NewPlaintTextRecord(std::string(text));
+}
+
+std::shared_ptr<PasteDataRecord> PasteDataRecord::NewPlaintTextRecord(std::string &&text)
+{
+    if (text.length() >= MAX_TEXT_LEN) {
+        return nullptr;
+    }
+    return NewTextRecord(MIME_ID_TEXT_PLAIN, std::move(text));
 }
 
 std::shared_ptr<PasteDataRecord> PasteDataRecord::NewUriRecord(const OHOS::Uri &uri)
 {
-    return std::make_shared<PasteDataRecord>(MIMETYPE_TEXT_URI,
-                                             nullptr,
-                                             nullptr,
-                                             nullptr,
-                                             std::make_shared<OHOS::Uri>(uri));
+    return NewTextRecord(MIME_ID_TEXT_URI, uri.ToString());
+}
+
+std::shared_ptr<PasteDataRecord> PasteDataRecord::NewTextRecord(MimeTypeId id, std::string &&text)
+{
+    auto record = std::make_shared<PasteDataRecord>();
+    record->mimeTypeId_ = id;
+    if (!record->EmplaceInline(text)) {
+        if (id == MIME_ID_TEXT_URI) {
+            record->payload_.emplace<PAYLOAD_URI>(std::make_shared<OHOS::Uri>(text));
+        } else if (id == MIME_ID_TEXT_HTML) {
+            record->payload_.emplace<PAYLOAD_HTML>(std::make_shared<std::string>(std::move(text)));
+        } else {
+            record->payload_.emplace<PAYLOAD_PLAIN>(std::make_shared<std::string>(std::move(text)));
+        }
+    }
+    record->UpdateSummary();
+    return record;
+}
+
+bool PasteDataRecord::EmplaceInline(std::string_view text)
+{
+    if (text.size() > InlineText::CAPACITY) {
+        return false;
+    }
+    auto &inlined = payload_.emplace<PAYLOAD_INLINE>();
+    inlined.size = static_cast<uint8_t>(text.size());
+    text.copy(inlined.data.data(), text.size());
+    return true;
+}
+
+const PasteDataRecord::InlineText *PasteDataRecord::GetInline(MimeTypeId id) const
+{
+    return (mimeTypeId_ == id) ? std::get_if<PAYLOAD_INLINE>(&payload_) : nullptr;
+}
+
+std::shared_ptr<PasteDataRecord> PasteDataRecord::NewSharedTextRecord(const std::string &mimeType,
+    std::shared_ptr<const SharedText> text)
+{
+    MimeTypeId id = MimeTypeRegistry::GetInstance().Find(mimeType);
+    if ((id != MIME_ID_TEXT_HTML && id != MIME_ID_TEXT_PLAIN) || text == nullptr ||
+        text->GetSize() >= MAX_TEXT_LEN) {
+        return nullptr;
+    }
+    auto record = std::make_shared<PasteDataRecord>();
+    record->mimeTypeId_ = id;
+    record->payload_.emplace<PAYLOAD_SHARED>(std::move(text));
+    record->UpdateSummary();
+    return record;
 }
 
 PasteDataRecord::PasteDataRecord(std::string mimeType,
@@ -67,148 +609,291 @@ PasteDataRecord::PasteDataRecord(std::string mimeType,
                                  std::shared_ptr<OHOS::AAFwk::Want> want,
                                  std::shared_ptr<std::string> plainText,
                                  std::shared_ptr<OHOS::Uri> uri)
-    : mimeType_ {std::move(mimeType)},
-      htmlText_ {std::move(htmlText)},
-      want_ {std::move(want)},
-      plainText_ {std::move(plainText)},
-      uri_ {std::move(uri)} {}
+    : mimeTypeId_ {MimeTypeRegistry::GetInstance().Register(mimeType)}
+{
+    if (mimeTypeId_ == MIME_ID_INVALID) {
+        customMimeType_ = std::make_shared<const std::string>(std::move(mimeType));
+    }
+    // keep the payload matching the mime type, or the first one given for other types
+    bool anyType = mimeTypeId_ >= MIME_ID_BUILTIN_COUNT;
+    if (htmlText != nullptr && (anyType || mimeTypeId_ == MIME_ID_TEXT_HTML)) {
+        payload_.emplace<PAYLOAD_HTML>(std::move(htmlText));
+    } else if (want != nullptr && (anyType || mimeTypeId_ == MIME_ID_TEXT_WANT)) {
+        payload_.emplace<PAYLOAD_WANT>(std::move(want));
+    } else if (plainText != nullptr && (anyType || mimeTypeId_ == MIME_ID_TEXT_PLAIN)) {
+        payload_.emplace<PAYLOAD_PLAIN>(std::move(plainText));
+    } else if (uri != nullptr && (anyType || mimeTypeId_ == MIME_ID_TEXT_URI)) {
+        payload_.emplace<PAYLOAD_URI>(std::move(uri));
+    }
+    UpdateSummary();
+}
+
+std::shared_ptr<std::string> PasteDataRecord::GetText(std::size_t payload, MimeTypeId id) const
+{
+    if (payload_.index() == payload) {
+        return (payload == PAYLOAD_HTML) ? std::get<PAYLOAD_HTML>(payload_) : std::get<PAYLOAD_PLAIN>(payload_);
+    }
+    if (payload_.index() == PAYLOAD_SHARED && mimeTypeId_ == id) {
+        auto &shared = std::get<PAYLOAD_SHARED>(payload_);
+        return std::make_shared<std::string>(shared->GetData(), shared->GetSize());
+    }
+    if (auto inlined = GetInline(id); inlined != nullptr) {
+        return std::make_shared<std::string>(inlined->View());
+    }
+    return nullptr;
+}
 
 std::shared_ptr<std::string> PasteDataRecord::GetHtmlText() const
 {
-    return this->htmlText_;
+    return GetText(PAYLOAD_HTML, MIME_ID_TEXT_HTML);
 }
 
-std::string PasteDataRecord::GetMimeType() const
+const std::string &PasteDataRecord::GetMimeType() const
 {
-    return this->mimeType_;
+    if (customMimeType_ != nullptr) {
+        return *customMimeType_;
+    }
+    return MimeTypeRegistry::GetInstance().GetName(mimeTypeId_);
+}
+
+MimeTypeId PasteDataRecord::GetMimeTypeId() const
+{
+    return this->mimeTypeId_;
 }
 
 std::shared_ptr<std::string> PasteDataRecord::GetPlainText() const
 {
-    return this->plainText_;
+    return GetText(PAYLOAD_PLAIN, MIME_ID_TEXT_PLAIN);
 }
 
 std::shared_ptr<OHOS::Uri> PasteDataRecord::GetUri() const
 {
-    return this->uri_;
+    if (auto inlined = GetInline(MIME_ID_TEXT_URI); inlined != nullptr) {
+        return std::make_shared<OHOS::Uri>(std::string(inlined->View()));
+    }
+    return payload_.index() == PAYLOAD_URI ? std::get<PAYLOAD_URI>(payload_) : nullptr;
 }
 
 std::shared_ptr<OHOS::AAFwk::Want> PasteDataRecord::GetWant() const
 {
-    return this->want_;
+    return payload_.index() == PAYLOAD_WANT ? std::get<PAYLOAD_WANT>(payload_) : nullptr;
 }
 std::string PasteDataRecord::ConvertToText() const
 {
-    if (this->htmlText_) {
-        return *this->htmlText_;
-    } else if (this->plainText_) {
-        return *this->plainText_;
-    } else if (this->uri_) {
-        return this->uri_->ToString();
-    } else {
-        return "";
+    auto codec = GetCodec(mimeTypeId_);
+    if (codec == nullptr) {
+        codec = GetPayloadCodec(payload_.index());
     }
+    return (codec != nullptr) ? codec->toText(*this) : "";
 }
 
-bool PasteDataRecord::Marshalling(Parcel &parcel) const
+uint64_t PasteDataRecord::GetFingerprint() const
 {
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start: %{public}s,", mimeType_.c_str());
-    // write mimeType_
-    if (!parcel.WriteString16(Str8ToStr16(mimeType_))) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
-        return false;
+    return fingerprint_;
+}
+
+std::size_t PasteDataRecord::GetContentSize() const
+{
+    return contentSize_;
+}
+
+std::string_view PasteDataRecord::GetContent(std::shared_ptr<const void> &owner) const
+{
+    if (IsEncoded()) {
+        // decoded into a record of the caller's, the shared one stays encoded
+        auto decoded = Decode();
+        return (decoded != nullptr) ? decoded->GetContent(owner) : std::string_view();
+    }
+    if (payload_.index() == PAYLOAD_HTML || payload_.index() == PAYLOAD_PLAIN) {
+        auto &text = (payload_.index() == PAYLOAD_HTML) ? std::get<PAYLOAD_HTML>(payload_) :
+            std::get<PAYLOAD_PLAIN>(payload_);
+        owner = text;
+        return (text != nullptr) ? std::string_view(*text) : std::string_view();
+    }
+    if (payload_.index() == PAYLOAD_SHARED) {
+        auto &shared = std::get<PAYLOAD_SHARED>(payload_);
+        owner = shared;
+        return std::string_view(shared->GetData(), shared->GetSize());
     }
+    auto text = std::make_shared<const std::string>(ConvertToText());
+    owner = text;
+    return std::string_view(*text);
+}
 
-    if (mimeType_ == MIMETYPE_TEXT_PLAIN) {
-        // write plainText_
-        if (plainText_ != nullptr) {
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "plainText_: %{public}s,", (*plainText_).c_str());
-            if (!parcel.WriteString16(Str8ToStr16(*plainText_))) {
-                PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed.");
-                return false;
-            }
-        }
-    } else if (mimeType_ == MIMETYPE_TEXT_HTML) {
-        if (htmlText_ != nullptr) {
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "htmlText_: %{public}s,", (*htmlText_).c_str());
-            if (!parcel.WriteString16(Str8ToStr16(*htmlText_))) {
-                PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed.");
-                return false;
-            }
-        }
-    } else if (mimeType_ == MIMETYPE_TEXT_URI) {
-        // write uri_
-        if (uri_ != nullptr) {
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "uri_: %{public}s,", uri_->ToString().c_str());
-            if (!parcel.WriteParcelable(uri_.get())) {
-                PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed.");
-                return false;
-            }
+void PasteDataRecord::UpdateSummary()
+{
+    // the type is the seed, so equal text of different types differs
+    const std::string &mimeType = GetMimeType();
+    uint64_t seed = ContentHash::Hash64(mimeType.data(), mimeType.size());
+    auto codec = GetCodec(mimeTypeId_);
+    if (codec == nullptr) {
+        codec = GetPayloadCodec(payload_.index());
+    }
+    fingerprint_ = (codec != nullptr) ? codec->hash(*this, seed) : seed;
+    contentSize_ = (codec != nullptr) ? codec->contentSize(*this) : 0;
+}
+
+std::size_t PasteDataRecord::SerializedSize(uint32_t version) const
+{
+    if (IsEncoded()) {
+        auto &encoded = std::get<PAYLOAD_ENCODED>(payload_);
+        if (encoded->version == version) {
+            return encoded->size;
         }
-    } else if (mimeType_ == MIMETYPE_TEXT_WANT) {
-        // write want
-        if (want_ != nullptr) {
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "Write want_");
-            if (!parcel.WriteParcelable(want_.get())) {
-                PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed.");
-                return false;
-            }
+        auto decoded = Decode();
+        return (decoded != nullptr) ? decoded->SerializedSize(version) : 0;
+    }
+    std::size_t size = (version >= PASTE_DATA_WIRE_V2) ? Utf8Size(GetMimeType()) : String16Size(GetMimeType());
+    auto codec = GetCodec(mimeTypeId_);
+    return (codec != nullptr) ? size + codec->size(*this, version) : size;
+}
+
+bool PasteDataRecord::Marshalling(Parcel &parcel) const
+{
+    return Marshalling(parcel, PASTE_DATA_WIRE_V1);
+}
+
+bool PasteDataRecord::Marshalling(Parcel &parcel, uint32_t version) const
+{
+    if (IsEncoded()) {
+        // a record read lazily is passed on as the bytes it came in when the layout matches
+        auto &encoded = std::get<PAYLOAD_ENCODED>(payload_);
+        if (encoded->version == version) {
+            return parcel.WriteBuffer(encoded->buffer->data() + encoded->offset, encoded->size);
         }
-    } else {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "Unkonw MimeType: %{public}s.", mimeType_.c_str());
+        auto decoded = Decode();
+        return (decoded != nullptr) && decoded->Marshalling(parcel, version);
+    }
+    const std::string &mimeType = GetMimeType();
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start: %{public}s,", mimeType.c_str());
+    // write mimeType
+    bool ret = (version >= PASTE_DATA_WIRE_V2) ? WriteUtf8(parcel, mimeType) :
+        parcel.WriteString16(ToUtf16(mimeType));
+    if (!ret) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write mimeType failed.");
+        return false;
+    }
+    auto codec = GetCodec(mimeTypeId_);
+    if (codec == nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "Unkonw MimeType: %{public}s.", mimeType.c_str());
+        return false;
+    }
+    if (!codec->encode(*this, parcel, version)) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "write failed.");
         return false;
     }
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
     return true;
 }
 
-bool PasteDataRecord::ReadFromParcel(Parcel &parcel)
+bool PasteDataRecord::ReadFromParcel(Parcel &parcel, uint32_t version)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
-    // read mimeType_
-    mimeType_ = Str16ToStr8(parcel.ReadString16());
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "mimeType_: %{public}s,", mimeType_.c_str());
-
-    if (mimeType_ == MIMETYPE_TEXT_HTML) {
-        // read htmlText_
-        htmlText_ = std::make_shared<std::string>(Str16ToStr8(parcel.ReadString16()));
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "htmlText_: %{public}s,", (*htmlText_).c_str());
-    } else if (mimeType_ == MIMETYPE_TEXT_PLAIN) {
-        // read plainText_
-        plainText_ = std::make_shared<std::string>(Str16ToStr8(parcel.ReadString16()));
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "plainText_: %{public}s,", (*plainText_).c_str());
-    } else if (mimeType_ == MIMETYPE_TEXT_URI) {
-        // read uri_
-        std::unique_ptr<OHOS::Uri> uri(parcel.ReadParcelable<OHOS::Uri>());
-        if (!uri) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "nullptr.");
-            return false;
-        }
-        uri_ = std::make_shared<OHOS::Uri>(*uri);
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "uri_: %{public}s,", uri_->ToString().c_str());
-    } else if (mimeType_ == MIMETYPE_TEXT_WANT) {
-        // read want_
-        std::unique_ptr<OHOS::AAFwk::Want> want(parcel.ReadParcelable<OHOS::AAFwk::Want>());
-        if (!want) {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "nullptr.");
+    // read mimeType
+    std::string mimeType;
+    if (version >= PASTE_DATA_WIRE_V2) {
+        if (!ReadUtf8(parcel, mimeType)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read mimeType failed.");
             return false;
         }
-        want_ = std::make_shared<OHOS::AAFwk::Want>(*want);
     } else {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "Unkonw MimeType: %{public}s.", mimeType_.c_str());
+        mimeType = ToUtf8(parcel.ReadString16());
+    }
+    mimeTypeId_ = MimeTypeRegistry::GetInstance().Find(mimeType);
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "mimeType: %{public}s,", mimeType.c_str());
+    auto codec = GetCodec(mimeTypeId_);
+    if (codec == nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "Unkonw MimeType: %{public}s.", mimeType.c_str());
         return false;
     }
-
+    if (!codec->decode(*this, parcel, version)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read payload failed.");
+        return false;
+    }
+    UpdateSummary();
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
     return true;
 }
 
-PasteDataRecord *PasteDataRecord::Unmarshalling(Parcel &parcel)
+std::shared_ptr<PasteDataRecord> PasteDataRecord::ReadEncoded(Parcel &parcel, uint32_t version,
+    const std::shared_ptr<const std::vector<uint8_t>> &buffer, std::size_t base)
 {
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
-    PasteDataRecord *pasteDataRecord = new PasteDataRecord();
+    std::size_t start = parcel.GetReadPosition();
+    std::string mimeType;
+    if (version >= PASTE_DATA_WIRE_V2) {
+        if (!ReadUtf8(parcel, mimeType)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read mimeType failed.");
+            return nullptr;
+        }
+    } else {
+        mimeType = ToUtf8(parcel.ReadString16());
+    }
+    MimeTypeId id = MimeTypeRegistry::GetInstance().Find(mimeType);
+    auto codec = GetCodec(id);
+    if (codec == nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "Unkonw MimeType: %{public}s.", mimeType.c_str());
+        return nullptr;
+    }
+    // a payload that cannot be skipped, such as text in shared memory, is decoded right away
+    std::size_t payloadStart = parcel.GetReadPosition();
+    std::size_t contentSize = 0;
+    if (!codec->lazy || !codec->skip(parcel, version, contentSize)) {
+        parcel.RewindRead(payloadStart);
+        auto record = std::make_shared<PasteDataRecord>();
+        record->mimeTypeId_ = id;
+        if (!codec->decode(*record, parcel, version)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read payload failed.");
+            return nullptr;
+        }
+        record->UpdateSummary();
+        return record;
+    }
+    // the fingerprint waits for the decode, the size is known from the walk
+    auto record = std::make_shared<PasteDataRecord>();
+    record->mimeTypeId_ = id;
+    record->contentSize_ = contentSize;
+    record->payload_.emplace<PAYLOAD_ENCODED>(std::make_shared<const EncodedPayload>(
+        EncodedPayload { buffer, start - base, parcel.GetReadPosition() - start, version }));
+    return record;
+}
+
+bool PasteDataRecord::IsEncoded() const
+{
+    return payload_.index() == PAYLOAD_ENCODED;
+}
+
+// The encoded bytes when the record has to be decoded to be written in version, 0 when it does not.
+std::size_t PasteDataRecord::GetDecodeSize(uint32_t version) const
+{
+    if (!IsEncoded()) {
+        return 0;
+    }
+    auto &encoded = std::get<PAYLOAD_ENCODED>(payload_);
+    return (encoded->version != version) ? encoded->size : 0;
+}
 
-    if (pasteDataRecord && !pasteDataRecord->ReadFromParcel(parcel)) {
+std::shared_ptr<PasteDataRecord> PasteDataRecord::Decode() const
+{
+    if (!IsEncoded()) {
+        return nullptr;
+    }
+    auto &encoded = std::get<PAYLOAD_ENCODED>(payload_);
+    Parcel parcel;
+    if (encoded->size > parcel.GetMaxCapacity()) {
+        parcel.SetMaxCapacity(encoded->size);
+    }
+    if (!parcel.WriteBuffer(encoded->buffer->data() + encoded->offset, encoded->size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "copy %{public}zu bytes failed.", encoded->size);
+        return nullptr;
+    }
+    return std::shared_ptr<PasteDataRecord>(Unmarshalling(parcel, encoded->version));
+}
+
+PasteDataRecord *PasteDataRecord::Unmarshalling(Parcel &parcel, uint32_t version)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    PasteDataRecord *pasteDataRecord = new (std::nothrow) PasteDataRecord();
+    if (pasteDataRecord != nullptr && !pasteDataRecord->ReadFromParcel(parcel, version)) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "delete end.");
         delete pasteDataRecord;
         pasteDataRecord = nullptr;
@@ -216,5 +901,10 @@ PasteDataRecord *PasteDataRecord::Unmarshalling(Parcel &parcel)
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
     return pasteDataRecord;
 }
+
+PasteDataRecord *PasteDataRecord::Unmarshalling(Parcel &parcel)
+{
+    return Unmarshalling(parcel, PASTE_DATA_WIRE_V1);
+}
 } // MiscServices
-} // OHOS
\ No newline at end of file
+} // OHOS
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paste_data_summary.h"
+#include <memory>
+#include <new>
+#include "pasteboard_hilog_wreapper.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+const std::uint32_t MAX_SUMMARY_RECORDS = 128;
+}
+
+bool PasteDataSummary::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteParcelable(&property.additions) || !parcel.WriteStringVector(property.mimeTypes) ||
+        !parcel.WriteString(property.tag) || !parcel.WriteInt64(property.timestamp) ||
+        !parcel.WriteBool(property.localOnly) || !parcel.WriteUint32(static_cast<uint32_t>(recordSizes.size()))) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write summary failed.");
+        return false;
+    }
+    for (auto size : recordSizes) {
+        if (!parcel.WriteUint64(size)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write record size failed.");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PasteDataSummary::ReadFromParcel(Parcel &parcel)
+{
+    std::unique_ptr<AAFwk::WantParams> additions(parcel.ReadParcelable<AAFwk::WantParams>());
+    if (additions == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read additions failed.");
+        return false;
+    }
+    property.additions = *additions;
+    uint32_t count = 0;
+    if (!parcel.ReadStringVector(&property.mimeTypes) || property.mimeTypes.size() > MAX_SUMMARY_RECORDS ||
+        !parcel.ReadString(property.tag) || !parcel.ReadInt64(property.timestamp) ||
+        !parcel.ReadBool(property.localOnly) || !parcel.ReadUint32(count) || count > MAX_SUMMARY_RECORDS) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read summary failed.");
+        return false;
+    }
+    recordSizes.resize(count);
+    for (auto &size : recordSizes) {
+        if (!parcel.ReadUint64(size)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read record size failed.");
+            return false;
+        }
+    }
+    return true;
+}
+
+PasteDataSummary *PasteDataSummary::Unmarshalling(Parcel &parcel)
+{
+    PasteDataSummary *summary = new (std::nothrow) PasteDataSummary();
+    if (summary != nullptr && !summary->ReadFromParcel(parcel)) {
+        delete summary;
+        summary = nullptr;
+    }
+    return summary;
+}
+} // MiscServices
+} // OHOS
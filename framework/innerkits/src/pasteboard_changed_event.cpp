@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_changed_event.h"
+#include <new>
+#include "pasteboard_hilog_wreapper.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+const std::size_t MAX_EVENT_MIME_TYPES = 128;
+}
+
+bool PasteboardChangedEvent::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteUint64(seq) || !parcel.WriteStringVector(mimeTypes) || !parcel.WriteUint32(recordCount) ||
+        !parcel.WriteUint64(totalBytes) || !parcel.WriteString(bundleName) || !parcel.WriteInt64(timestamp)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "write event failed.");
+        return false;
+    }
+    return true;
+}
+
+bool PasteboardChangedEvent::ReadFromParcel(Parcel &parcel)
+{
+    if (!parcel.ReadUint64(seq) || !parcel.ReadStringVector(&mimeTypes) || mimeTypes.size() > MAX_EVENT_MIME_TYPES ||
+        !parcel.ReadUint32(recordCount) || !parcel.ReadUint64(totalBytes) || !parcel.ReadString(bundleName) ||
+        !parcel.ReadInt64(timestamp)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read event failed.");
+        return false;
+    }
+    return true;
+}
+
+PasteboardChangedEvent *PasteboardChangedEvent::Unmarshalling(Parcel &parcel)
+{
+    PasteboardChangedEvent *event = new (std::nothrow) PasteboardChangedEvent();
+    if (event != nullptr && !event->ReadFromParcel(parcel)) {
+        delete event;
+        event = nullptr;
+    }
+    return event;
+}
+} // MiscServices
+} // OHOS
@@ -12,7 +12,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <if_system_ability_manager.h>
+#include <ipc_object_stub.h>
 #include <ipc_skeleton.h>
 #include <iservice_registry.h>
 #include "string_ex.h"
@@ -26,7 +28,14 @@ namespace MiscServices {
 sptr<IPasteboardService> PasteboardClient::pasteboardServiceProxy_;
 std::mutex PasteboardClient::instanceLock_;
 
-PasteboardClient::PasteboardClient() {};
+namespace {
+const std::u16string SESSION_TOKEN_DESCRIPTOR = u"ohos.miscservices.pasteboard.SessionToken";
+}
+
+PasteboardClient::PasteboardClient()
+{
+    sessionToken_ = new (std::nothrow) IPCObjectStub(SESSION_TOKEN_DESCRIPTOR);
+}
 PasteboardClient::~PasteboardClient()
 {
     if (pasteboardServiceProxy_ != nullptr) {
@@ -39,10 +48,16 @@ PasteboardClient::~PasteboardClient()
 
 std::shared_ptr<PasteDataRecord> PasteboardClient::CreateHtmlTextRecord(const std::string &htmlText)
 {
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New text record: %{public}s", htmlText.c_str());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New text record of %{public}zu bytes", htmlText.size());
     return PasteDataRecord::NewHtmlRecord(htmlText);
 }
 
+std::shared_ptr<PasteDataRecord> PasteboardClient::CreateHtmlTextRecord(std::string &&htmlText)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New text record of %{public}zu bytes", htmlText.size());
+    return PasteDataRecord::NewHtmlRecord(std::move(htmlText));
+}
+
 std::shared_ptr<PasteDataRecord> PasteboardClient::CreateWantRecord(std::shared_ptr<OHOS::AAFwk::Want> want)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New want record");
@@ -51,10 +66,16 @@ std::shared_ptr<PasteDataRecord> PasteboardClient::CreateWantRecord(std::shared_
 
 std::shared_ptr<PasteDataRecord> PasteboardClient::CreatePlainTextRecord(const std::string &text)
 {
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New text record: %{public}s", text.c_str());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New text record of %{public}zu bytes", text.size());
     return PasteDataRecord::NewPlaintTextRecord(text);
 }
 
+std::shared_ptr<PasteDataRecord> PasteboardClient::CreatePlainTextRecord(std::string &&text)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New text record of %{public}zu bytes", text.size());
+    return PasteDataRecord::NewPlaintTextRecord(std::move(text));
+}
+
 std::shared_ptr<PasteDataRecord> PasteboardClient::CreateUriRecord(const OHOS::Uri &uri)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New uri record");
@@ -63,12 +84,20 @@ std::shared_ptr<PasteDataRecord> PasteboardClient::CreateUriRecord(const OHOS::U
 
 std::shared_ptr<PasteData> PasteboardClient::CreateHtmlData(const std::string &htmlText)
 {
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New htmlText data: %{public}s", htmlText.c_str());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New htmlText data of %{public}zu bytes", htmlText.size());
     auto pasteData = std::make_shared<PasteData>();
     pasteData->AddHtmlRecord(htmlText);
     return pasteData;
 }
 
+std::shared_ptr<PasteData> PasteboardClient::CreateHtmlData(std::string &&htmlText)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New htmlText data of %{public}zu bytes", htmlText.size());
+    auto pasteData = std::make_shared<PasteData>();
+    pasteData->AddHtmlRecord(std::move(htmlText));
+    return pasteData;
+}
+
 std::shared_ptr<PasteData> PasteboardClient::CreateWantData(std::shared_ptr<OHOS::AAFwk::Want> want)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New want data");
@@ -79,12 +108,20 @@ std::shared_ptr<PasteData> PasteboardClient::CreateWantData(std::shared_ptr<OHOS
 
 std::shared_ptr<PasteData> PasteboardClient::CreatePlainTextData(const std::string &text)
 {
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New plain data: %{public}s", text.c_str());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New plain data of %{public}zu bytes", text.size());
     auto pasteData = std::make_shared<PasteData>();
     pasteData->AddTextRecord(text);
     return pasteData;
 }
 
+std::shared_ptr<PasteData> PasteboardClient::CreatePlainTextData(std::string &&text)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New plain data of %{public}zu bytes", text.size());
+    auto pasteData = std::make_shared<PasteData>();
+    pasteData->AddTextRecord(std::move(text));
+    return pasteData;
+}
+
 std::shared_ptr<PasteData> PasteboardClient::CreateUriData(const OHOS::Uri &uri)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "New uri data");
@@ -142,6 +179,191 @@ bool PasteboardClient::HasPasteData()
     return result;
 }
 
+int64_t PasteboardClient::GetChangeCount()
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "GetChangeCount quit ");
+        return -1;
+    }
+    return pasteboardServiceProxy_->GetChangeCount();
+}
+
+bool PasteboardClient::GetPasteDataIfChanged(int64_t &changeCount, PasteData &pasteData, bool &modified)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    modified = false;
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "GetPasteDataIfChanged quit.");
+        return false;
+    }
+    return pasteboardServiceProxy_->GetPasteDataIfChanged(changeCount, pasteData, modified);
+}
+
+bool PasteboardClient::GetPasteDataSummary(PasteDataSummary &summary)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "GetPasteDataSummary quit.");
+        return false;
+    }
+    return pasteboardServiceProxy_->GetPasteDataSummary(summary);
+}
+
+std::shared_ptr<PasteDataRecord> PasteboardClient::GetRecordAt(std::size_t index)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (index > UINT32_MAX) {
+        return nullptr;
+    }
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "GetRecordAt quit.");
+        return nullptr;
+    }
+    PasteData data;
+    if (!pasteboardServiceProxy_->GetRecordAt(static_cast<uint32_t>(index), data)) {
+        return nullptr;
+    }
+    return data.GetRecordAt(0);
+}
+
+std::shared_ptr<PasteDataRecord> PasteboardClient::GetFirstRecord(const std::string &mimeType)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "GetFirstRecord quit.");
+        return nullptr;
+    }
+    PasteData data;
+    if (!pasteboardServiceProxy_->GetFirstRecord(mimeType, data)) {
+        return nullptr;
+    }
+    return data.GetRecordAt(0);
+}
+
+uint32_t PasteboardClient::OpenRecordReader(std::size_t index, std::string &mimeType, uint64_t &size)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (index > UINT32_MAX) {
+        return 0;
+    }
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "OpenRecordReader quit.");
+        return 0;
+    }
+    return pasteboardServiceProxy_->OpenRecordReader(static_cast<uint32_t>(index), sessionToken_, mimeType, size);
+}
+
+bool PasteboardClient::ReadRecordChunk(uint32_t readerId, uint64_t offset, uint32_t length, std::string &chunk)
+{
+    // a reader lives in the service it was opened in, reconnecting would not bring it back
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "ReadRecordChunk quit.");
+        return false;
+    }
+    return pasteboardServiceProxy_->ReadRecordChunk(readerId, offset,
+        std::min(length, IPasteboardService::MAX_RECORD_CHUNK_SIZE), chunk);
+}
+
+void PasteboardClient::CloseRecordReader(uint32_t readerId)
+{
+    if (pasteboardServiceProxy_ == nullptr) {
+        return;
+    }
+    pasteboardServiceProxy_->CloseRecordReader(readerId);
+}
+
+uint32_t PasteboardClient::BeginPasteWriter()
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "BeginPasteWriter quit.");
+        return 0;
+    }
+    return pasteboardServiceProxy_->BeginPasteWriter(sessionToken_);
+}
+
+bool PasteboardClient::AddWriterRecord(uint32_t writerId, const std::string &mimeType, uint64_t size)
+{
+    // a writer lives in the service it was begun in, reconnecting would not bring it back
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "AddWriterRecord quit.");
+        return false;
+    }
+    return pasteboardServiceProxy_->AddWriterRecord(writerId, mimeType, size);
+}
+
+bool PasteboardClient::WriteRecordChunk(uint32_t writerId, const char *data, std::size_t size)
+{
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "WriteRecordChunk quit.");
+        return false;
+    }
+    if (data == nullptr) {
+        return size == 0;
+    }
+    const std::size_t maxChunk = IPasteboardService::MAX_RECORD_CHUNK_SIZE;
+    for (std::size_t offset = 0; offset < size; offset += maxChunk) {
+        if (!pasteboardServiceProxy_->AppendWriterChunk(writerId, data + offset, std::min(size - offset, maxChunk))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PasteboardClient::CommitPasteWriter(uint32_t writerId)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "CommitPasteWriter quit.");
+        return false;
+    }
+    return pasteboardServiceProxy_->CommitPasteWriter(writerId);
+}
+
+void PasteboardClient::AbortPasteWriter(uint32_t writerId)
+{
+    if (pasteboardServiceProxy_ == nullptr) {
+        return;
+    }
+    pasteboardServiceProxy_->AbortPasteWriter(writerId);
+}
+
 void PasteboardClient::SetPasteData(PasteData& pasteData)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
@@ -157,7 +379,8 @@ void PasteboardClient::SetPasteData(PasteData& pasteData)
     pasteboardServiceProxy_->SetPasteData(pasteData);
 }
 
-void PasteboardClient::AddPasteboardChangedObserver(std::shared_ptr<PasteboardObserver> callback)
+void PasteboardClient::AddPasteboardChangedObserver(std::shared_ptr<PasteboardObserver> callback,
+    const std::vector<std::string> &mimeTypes)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
     if (callback == nullptr) {
@@ -176,7 +399,7 @@ void PasteboardClient::AddPasteboardChangedObserver(std::shared_ptr<PasteboardOb
 
     auto remoteObject = callback->AsObject();
     sptr<IPasteboardChangedObserver> observerPtr = iface_cast<IPasteboardChangedObserver>(remoteObject);
-    pasteboardServiceProxy_->AddPasteboardChangedObserver(observerPtr);
+    pasteboardServiceProxy_->AddPasteboardChangedObserver(observerPtr, mimeTypes);
     return;
 }
 
@@ -205,6 +428,50 @@ void PasteboardClient::RemovePasteboardChangedObserver(std::shared_ptr<Pasteboar
     return;
 }
 
+void PasteboardClient::AddPasteboardEventObserver(std::shared_ptr<PasteboardObserver> callback)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (callback == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "input nullptr.");
+        return;
+    }
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "AddPasteboardEventObserver quit.");
+        return;
+    }
+
+    auto remoteObject = callback->AsObject();
+    sptr<IPasteboardChangedObserver> observerPtr = iface_cast<IPasteboardChangedObserver>(remoteObject);
+    pasteboardServiceProxy_->AddPasteboardEventObserver(observerPtr);
+}
+
+void PasteboardClient::RemovePasteboardEventObserver(std::shared_ptr<PasteboardObserver> callback)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (callback == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "input nullptr.");
+        return;
+    }
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_CLIENT, "Redo ConnectService");
+        ConnectService();
+    }
+
+    if (pasteboardServiceProxy_ == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "RemovePasteboardEventObserver quit.");
+        return;
+    }
+
+    auto remoteObject = callback->AsObject();
+    sptr<IPasteboardChangedObserver> observerPtr = iface_cast<IPasteboardChangedObserver>(remoteObject);
+    pasteboardServiceProxy_->RemovePasteboardEventObserver(observerPtr);
+}
+
 void PasteboardClient::ConnectService()
 {
     std::lock_guard<std::mutex> lock(instanceLock_);
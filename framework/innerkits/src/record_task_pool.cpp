@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "record_task_pool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include "pasteboard_hilog_wreapper.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr std::size_t MAX_WORKERS = 3;
+// below this much record data per clip the serial codec is faster, see PasteDataCodecBenchmark
+constexpr std::size_t DEFAULT_MIN_BYTES = 256 * 1024;
+
+struct ParallelState {
+    std::atomic<std::size_t> next { 0 };
+    std::size_t count = 0;
+    const std::function<void(std::size_t)> *task = nullptr;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::size_t done = 0;
+};
+
+// Workers that start after the last index was taken find nothing to do, the state outlives them.
+void RunTasks(const std::shared_ptr<ParallelState> &state)
+{
+    std::size_t ran = 0;
+    for (std::size_t i = state->next++; i < state->count; i = state->next++) {
+        (*state->task)(i);
+        ran++;
+    }
+    if (ran == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->done += ran;
+    if (state->done == state->count) {
+        state->finished.notify_all();
+    }
+}
+} // namespace
+
+RecordTaskPool &RecordTaskPool::GetInstance()
+{
+    static RecordTaskPool instance;
+    return instance;
+}
+
+RecordTaskPool::RecordTaskPool() : pool_("PasteRecordCodec"), minBytes_(DEFAULT_MIN_BYTES)
+{
+    // the calling thread works too, one core is left for it
+    std::size_t cores = std::thread::hardware_concurrency();
+    threads_ = std::min(MAX_WORKERS, cores > 1 ? cores - 1 : 0);
+}
+
+RecordTaskPool::~RecordTaskPool()
+{
+    pool_.Stop();
+}
+
+bool RecordTaskPool::ShouldSplit(std::size_t count, std::size_t bytes) const
+{
+    // with no worker to hand records to, splitting only adds the copy of the parts
+    return count > 1 && threads_ > 0 && bytes >= minBytes_.load(std::memory_order_relaxed);
+}
+
+void RecordTaskPool::SetMinBytes(std::size_t bytes)
+{
+    minBytes_.store(bytes, std::memory_order_relaxed);
+}
+
+void RecordTaskPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)> &task)
+{
+    std::call_once(started_, [this]() {
+        running_ = threads_ > 0 && pool_.Start(static_cast<int>(threads_)) == 0;
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "workers: %{public}zu, running: %{public}d.", threads_, running_);
+    });
+    auto state = std::make_shared<ParallelState>();
+    state->count = count;
+    state->task = &task;
+    std::size_t helpers = running_ ? std::min(threads_, count > 0 ? count - 1 : 0) : 0;
+    for (std::size_t i = 0; i < helpers; i++) {
+        pool_.AddTask([state]() { RunTasks(state); });
+    }
+    RunTasks(state);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state]() { return state->done == state->count; });
+}
+} // MiscServices
+} // OHOS
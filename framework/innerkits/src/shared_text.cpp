@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_text.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <limits>
+#include "ipc_file_descriptor.h"
+#include "paste_data_record.h"
+#include "pasteboard_hilog_wreapper.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr const char *REGION_NAME = "PasteboardText";
+// Once these are set no writable mapping of the region exists, none can be made and write() fails on every
+// descriptor of it, nor can the size change. Ashmem protection only stops new writable mappings.
+constexpr unsigned int TEXT_SEALS = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+// A sealable memfd of size bytes, mapped writable.
+sptr<Ashmem> CreateRegion(std::size_t size)
+{
+    if (size == 0 || size > static_cast<std::size_t>(std::numeric_limits<int32_t>::max())) {
+        return nullptr;
+    }
+    int fd = memfd_create(REGION_NAME, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "create %{public}zu bytes failed.", size);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return nullptr;
+    }
+    sptr<Ashmem> region = new (std::nothrow) Ashmem(fd, static_cast<int32_t>(size));
+    if (region == nullptr) {
+        close(fd);
+        return nullptr;
+    }
+    if (!region->MapReadAndWriteAshmem()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "map %{public}zu bytes failed.", size);
+        region->CloseAshmem();
+        return nullptr;
+    }
+    return region;
+}
+
+// Drops the writable mapping, which the kernel requires before it seals writes, then maps read-only.
+bool SealRegion(Ashmem &region)
+{
+    region.UnmapAshmem();
+    if (fcntl(region.GetAshmemFd(), F_ADD_SEALS, TEXT_SEALS) != 0 || !region.MapReadOnlyAshmem()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "seal failed.");
+        region.CloseAshmem();
+        return false;
+    }
+    return true;
+}
+
+bool IsSealed(int fd)
+{
+    int seals = fcntl(fd, F_GET_SEALS);
+    return seals >= 0 && (static_cast<unsigned int>(seals) & TEXT_SEALS) == TEXT_SEALS;
+}
+}
+
+SharedText::SharedText(sptr<Ashmem> ashmem, std::size_t size) : ashmem_ {std::move(ashmem)}, size_ {size}
+{
+    if (ashmem_ != nullptr && size_ > 0) {
+        data_ = static_cast<const char *>(ashmem_->ReadFromAshmem(static_cast<int32_t>(size_), 0));
+    }
+}
+
+SharedText::~SharedText()
+{
+    if (ashmem_ != nullptr) {
+        ashmem_->UnmapAshmem();
+        ashmem_->CloseAshmem();
+    }
+}
+
+std::shared_ptr<const SharedText> SharedText::Create(const char *data, std::size_t size)
+{
+    sptr<Ashmem> ashmem = CreateRegion(size);
+    if (ashmem == nullptr) {
+        return nullptr;
+    }
+    if (!ashmem->WriteToAshmem(data, static_cast<int32_t>(size), 0)) {
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    if (!SealRegion(*ashmem)) {
+        return nullptr;
+    }
+    auto text = std::make_shared<const SharedText>(std::move(ashmem), size);
+    return (text->GetData() != nullptr) ? text : nullptr;
+}
+
+std::shared_ptr<const SharedText> SharedText::Unmarshalling(Parcel &parcel)
+{
+    uint32_t size = 0;
+    if (!parcel.ReadUint32(size) || size == 0) {
+        return nullptr;
+    }
+    // the factories hold text to the same cap, a region must not be a way around it
+    if (size >= PasteDataRecord::MAX_TEXT_SIZE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "region of %{public}u bytes too large.", size);
+        return nullptr;
+    }
+    sptr<IPCFileDescriptor> descriptor = parcel.ReadObject<IPCFileDescriptor>();
+    if (descriptor == nullptr || descriptor->GetFd() < 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "read fd failed.");
+        return nullptr;
+    }
+    // the descriptor in the parcel goes with it, the region keeps its own
+    int fd = dup(descriptor->GetFd());
+    if (fd < 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "dup fd failed.");
+        return nullptr;
+    }
+    // a sender that kept write access could change the text under every reader, after its size was checked
+    // and its fingerprint taken, so only a region whose seals rule that out is accepted
+    if (!IsSealed(fd)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "region not sealed.");
+        close(fd);
+        return nullptr;
+    }
+    // regions are created at the size of their text, anything beyond it would be mapped and kept for nothing
+    struct stat region = {};
+    if (fstat(fd, &region) != 0 || region.st_size != static_cast<off_t>(size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "region does not hold %{public}u bytes.", size);
+        close(fd);
+        return nullptr;
+    }
+    sptr<Ashmem> ashmem = new (std::nothrow) Ashmem(fd, static_cast<int32_t>(size));
+    if (ashmem == nullptr) {
+        close(fd);
+        return nullptr;
+    }
+    if (!ashmem->MapReadOnlyAshmem()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "map failed.");
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    auto text = std::make_shared<const SharedText>(std::move(ashmem), size);
+    return (text->GetData() != nullptr) ? text : nullptr;
+}
+
+bool SharedText::Marshalling(Parcel &parcel) const
+{
+    if (ashmem_ == nullptr || !parcel.WriteUint32(static_cast<uint32_t>(size_))) {
+        return false;
+    }
+    // as MessageParcel::WriteFileDescriptor, the parcel owns the duplicate
+    int fd = dup(ashmem_->GetAshmemFd());
+    if (fd < 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "dup fd failed.");
+        return false;
+    }
+    sptr<IPCFileDescriptor> descriptor = new (std::nothrow) IPCFileDescriptor(fd);
+    if (descriptor == nullptr) {
+        close(fd);
+        return false;
+    }
+    return parcel.WriteObject<IPCFileDescriptor>(descriptor);
+}
+
+SharedTextBuilder::SharedTextBuilder(sptr<Ashmem> ashmem, std::size_t capacity)
+    : ashmem_ {std::move(ashmem)}, capacity_ {capacity}
+{
+}
+
+SharedTextBuilder::~SharedTextBuilder()
+{
+    if (ashmem_ != nullptr) {
+        ashmem_->UnmapAshmem();
+        ashmem_->CloseAshmem();
+    }
+}
+
+std::unique_ptr<SharedTextBuilder> SharedTextBuilder::Create(std::size_t capacity)
+{
+    sptr<Ashmem> ashmem = CreateRegion(capacity);
+    if (ashmem == nullptr) {
+        return nullptr;
+    }
+    return std::make_unique<SharedTextBuilder>(std::move(ashmem), capacity);
+}
+
+bool SharedTextBuilder::Append(const char *data, std::size_t size)
+{
+    if (ashmem_ == nullptr || size > capacity_ - size_) {
+        return false;
+    }
+    if (size == 0) {
+        return true;
+    }
+    if (!ashmem_->WriteToAshmem(data, static_cast<int32_t>(size), static_cast<int32_t>(size_))) {
+        return false;
+    }
+    size_ += size;
+    return true;
+}
+
+std::shared_ptr<const SharedText> SharedTextBuilder::Seal()
+{
+    if (ashmem_ == nullptr || size_ == 0) {
+        return nullptr;
+    }
+    sptr<Ashmem> ashmem = std::move(ashmem_);
+    ashmem_ = nullptr;
+    if (!SealRegion(*ashmem)) {
+        return nullptr;
+    }
+    auto text = std::make_shared<const SharedText>(std::move(ashmem), size_);
+    return (text->GetData() != nullptr) ? text : nullptr;
+}
+
+std::size_t SharedTextBuilder::GetSize() const
+{
+    return size_;
+}
+
+const char *SharedText::GetData() const
+{
+    return data_;
+}
+
+std::size_t SharedText::GetSize() const
+{
+    return size_;
+}
+} // MiscServices
+} // OHOS
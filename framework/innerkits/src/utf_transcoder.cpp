@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utf_transcoder.h"
+#include <cstddef>
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr char16_t HIGH_SURROGATE_MIN = 0xD800;
+constexpr char16_t LOW_SURROGATE_MIN = 0xDC00;
+constexpr char16_t LOW_SURROGATE_MAX = 0xDFFF;
+constexpr uint32_t SUPPLEMENTARY_MIN = 0x10000;
+constexpr uint32_t ASCII_MAX = 0x7F;
+constexpr uint32_t TWO_BYTE_MAX = 0x7FF;
+
+#if defined(__AVX2__)
+constexpr const char *BACKEND = "avx2";
+constexpr std::size_t BLOCK = 32;
+
+std::size_t WidenAscii(const uint8_t *src, std::size_t len, char16_t *dst)
+{
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        if (_mm256_movemask_epi8(v) != 0) {
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + BLOCK / 2),
+            _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+    }
+    return i;
+}
+
+std::size_t SkipAscii(const uint8_t *src, std::size_t len)
+{
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i))) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+std::size_t NarrowAscii(const char16_t *src, std::size_t len, uint8_t *dst)
+{
+    const __m256i mask = _mm256_set1_epi16(static_cast<int16_t>(0xFF80));
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + BLOCK / 2));
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), mask)) {
+            break;
+        }
+        // packus works per 128-bit lane, put the quadwords back in order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+    }
+    return i;
+}
+#elif defined(__SSE2__)
+constexpr const char *BACKEND = "sse2";
+constexpr std::size_t BLOCK = 16;
+
+std::size_t WidenAscii(const uint8_t *src, std::size_t len, char16_t *dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (_mm_movemask_epi8(v) != 0) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + BLOCK / 2), _mm_unpackhi_epi8(v, zero));
+    }
+    return i;
+}
+
+std::size_t SkipAscii(const uint8_t *src, std::size_t len)
+{
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))) != 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+std::size_t NarrowAscii(const char16_t *src, std::size_t len, uint8_t *dst)
+{
+    const __m128i mask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + BLOCK / 2));
+        __m128i high = _mm_and_si128(_mm_or_si128(a, b), mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(a, b));
+    }
+    return i;
+}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+constexpr const char *BACKEND = "neon";
+constexpr std::size_t BLOCK = 16;
+
+bool IsZero(uint64x2_t v)
+{
+    return (vgetq_lane_u64(v, 0) | vgetq_lane_u64(v, 1)) == 0;
+}
+
+std::size_t WidenAscii(const uint8_t *src, std::size_t len, char16_t *dst)
+{
+    const uint8x16_t mask = vdupq_n_u8(0x80);
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        uint8x16_t v = vld1q_u8(src + i);
+        if (!IsZero(vreinterpretq_u64_u8(vandq_u8(v, mask)))) {
+            break;
+        }
+        vst1q_u16(reinterpret_cast<uint16_t *>(dst + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16(reinterpret_cast<uint16_t *>(dst + i + BLOCK / 2), vmovl_u8(vget_high_u8(v)));
+    }
+    return i;
+}
+
+std::size_t SkipAscii(const uint8_t *src, std::size_t len)
+{
+    const uint8x16_t mask = vdupq_n_u8(0x80);
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        if (!IsZero(vreinterpretq_u64_u8(vandq_u8(vld1q_u8(src + i), mask)))) {
+            break;
+        }
+    }
+    return i;
+}
+
+std::size_t NarrowAscii(const char16_t *src, std::size_t len, uint8_t *dst)
+{
+    const uint16x8_t mask = vdupq_n_u16(0xFF80);
+    std::size_t i = 0;
+    for (; i + BLOCK <= len; i += BLOCK) {
+        uint16x8_t a = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i));
+        uint16x8_t b = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i + BLOCK / 2));
+        if (!IsZero(vreinterpretq_u64_u16(vandq_u16(vorrq_u16(a, b), mask)))) {
+            break;
+        }
+        vst1q_u8(dst + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+    }
+    return i;
+}
+#else
+constexpr const char *BACKEND = "scalar";
+constexpr std::size_t BLOCK = 16;
+
+std::size_t WidenAscii(const uint8_t *src, std::size_t len, char16_t *dst)
+{
+    return 0;
+}
+
+std::size_t SkipAscii(const uint8_t *src, std::size_t len)
+{
+    return 0;
+}
+
+std::size_t NarrowAscii(const char16_t *src, std::size_t len, uint8_t *dst)
+{
+    return 0;
+}
+#endif
+
+bool IsContinuation(uint8_t c)
+{
+    return (c & 0xC0) == 0x80;
+}
+
+// Decodes one sequence at src[i], rejecting overlong forms, surrogates and values past U+10FFFF.
+bool DecodeUtf8(const uint8_t *src, std::size_t len, std::size_t &i, uint32_t &cp)
+{
+    uint8_t c = src[i];
+    std::size_t count = 0;
+    uint8_t low = 0x80;
+    uint8_t high = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) {
+        count = 1;
+        cp = c & 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        count = 2;
+        cp = c & 0x0F;
+        low = (c == 0xE0) ? 0xA0 : low;
+        high = (c == 0xED) ? 0x9F : high;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        count = 3;
+        cp = c & 0x07;
+        low = (c == 0xF0) ? 0x90 : low;
+        high = (c == 0xF4) ? 0x8F : high;
+    } else {
+        return false;
+    }
+    if (len - i <= count || src[i + 1] < low || src[i + 1] > high) {
+        return false;
+    }
+    for (std::size_t k = 1; k <= count; k++) {
+        if (!IsContinuation(src[i + k])) {
+            return false;
+        }
+        cp = (cp << 6) | (src[i + k] & 0x3F);
+    }
+    i += count + 1;
+    return true;
+}
+
+} // namespace
+
+bool UtfTranscoder::Utf8ToUtf16(const std::string &in, std::u16string &out)
+{
+    // never more units than bytes, the result is usually short lived so the slack is not trimmed
+    out.resize(in.size());
+    const uint8_t *src = reinterpret_cast<const uint8_t *>(in.data());
+    std::size_t len = in.size();
+    char16_t *dst = &out[0];
+    std::size_t i = 0;
+    std::size_t n = 0;
+    while (i < len) {
+        std::size_t run = WidenAscii(src + i, len - i, dst + n);
+        i += run;
+        n += run;
+        // go back to the vector path after about a block of mixed text
+        std::size_t limit = (len - i > BLOCK) ? i + BLOCK : len;
+        while (i < limit) {
+            if (src[i] <= ASCII_MAX) {
+                dst[n++] = src[i++];
+                continue;
+            }
+            uint32_t cp = 0;
+            if (!DecodeUtf8(src, len, i, cp)) {
+                out.clear();
+                return false;
+            }
+            if (cp >= SUPPLEMENTARY_MIN) {
+                cp -= SUPPLEMENTARY_MIN;
+                dst[n++] = static_cast<char16_t>(HIGH_SURROGATE_MIN + (cp >> 10));
+                dst[n++] = static_cast<char16_t>(LOW_SURROGATE_MIN + (cp & 0x3FF));
+            } else {
+                dst[n++] = static_cast<char16_t>(cp);
+            }
+        }
+    }
+    out.resize(n);
+    return true;
+}
+
+bool UtfTranscoder::Utf16ToUtf8(const std::u16string &in, std::string &out)
+{
+    // sized exactly, the result is what gets stored in the record
+    const char16_t *src = in.data();
+    std::size_t len = in.size();
+    out.resize(Utf8Length(src, len));
+    uint8_t *dst = reinterpret_cast<uint8_t *>(&out[0]);
+    std::size_t i = 0;
+    std::size_t n = 0;
+    while (i < len) {
+        std::size_t run = NarrowAscii(src + i, len - i, dst + n);
+        i += run;
+        n += run;
+        std::size_t limit = (len - i > BLOCK) ? i + BLOCK : len;
+        while (i < limit) {
+            uint32_t cp = src[i++];
+            if (cp <= ASCII_MAX) {
+                dst[n++] = static_cast<uint8_t>(cp);
+            } else if (cp <= TWO_BYTE_MAX) {
+                dst[n++] = static_cast<uint8_t>(0xC0 | (cp >> 6));
+                dst[n++] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+            } else if (cp < HIGH_SURROGATE_MIN || cp > LOW_SURROGATE_MAX) {
+                dst[n++] = static_cast<uint8_t>(0xE0 | (cp >> 12));
+                dst[n++] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+                dst[n++] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+            } else if (cp < LOW_SURROGATE_MIN && i < len && src[i] >= LOW_SURROGATE_MIN &&
+                src[i] <= LOW_SURROGATE_MAX) {
+                cp = SUPPLEMENTARY_MIN + ((cp - HIGH_SURROGATE_MIN) << 10) + (src[i++] - LOW_SURROGATE_MIN);
+                dst[n++] = static_cast<uint8_t>(0xF0 | (cp >> 18));
+                dst[n++] = static_cast<uint8_t>(0x80 | ((cp >> 12) & 0x3F));
+                dst[n++] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+                dst[n++] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+            } else {
+                out.clear();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool UtfTranscoder::IsUtf8(const char *data, std::size_t size)
+{
+    const uint8_t *src = reinterpret_cast<const uint8_t *>(data);
+    std::size_t i = 0;
+    while (i < size) {
+        i += SkipAscii(src + i, size - i);
+        std::size_t limit = (size - i > BLOCK) ? i + BLOCK : size;
+        while (i < limit) {
+            uint32_t cp = 0;
+            if (src[i] <= ASCII_MAX) {
+                i++;
+            } else if (!DecodeUtf8(src, size, i, cp)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// each half of a surrogate pair accounts for two bytes
+std::size_t UtfTranscoder::Utf8Length(const char16_t *src, std::size_t len)
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < len; i++) {
+        char16_t u = src[i];
+        size += (u <= ASCII_MAX) ? 1 : ((u <= TWO_BYTE_MAX || (u >= HIGH_SURROGATE_MIN && u <= LOW_SURROGATE_MAX)) ?
+            2 : 3);
+    }
+    return size;
+}
+
+const char *UtfTranscoder::GetBackend()
+{
+    return BACKEND;
+}
+} // MiscServices
+} // OHOS
@@ -148,6 +148,43 @@ declare namespace pasteboard {
      */
   }
 
+  /**
+   * Describes a change of the system pasteboard, delivered to 'update' callbacks.
+   * @since 9
+   */
+  interface PasteboardChangedEvent {
+    /**
+     * change sequence number of the current user's pasteboard, increased by every set or clear.
+     * @since 9
+     */
+    readonly seq: number;
+    /**
+     * MIME types of all records in the new PasteData, empty after a clear.
+     * @since 9
+     */
+    readonly mimeTypes: Array<string>;
+    /**
+     * the number of records in the new PasteData.
+     * @since 9
+     */
+    readonly recordCount: number;
+    /**
+     * the total content size of all records in bytes.
+     * @since 9
+     */
+    readonly totalBytes: number;
+    /**
+     * the bundle name of the application that changed the pasteboard.
+     * @since 9
+     */
+    readonly bundleName: string;
+    /**
+     * the time of the change in milliseconds since epoch.
+     * @since 9
+     */
+    readonly timestamp: number;
+  }
+
   interface PasteDataRecord {
     /**
      * HTML text in a record.
@@ -316,19 +353,97 @@ declare namespace pasteboard {
     replaceRecordAt(index: number, record: PasteDataRecord): boolean;
   }
 
+  /**
+   * Reads the content of one pasteboard record in chunks. It keeps the content it was opened on,
+   * and can be used with for await.
+   * @since 9
+   */
+  interface RecordReader {
+    /**
+     * MIME type of the record.
+     * @since 9
+     */
+    readonly mimeType: string;
+
+    /**
+     * Size of the content in UTF-8 bytes.
+     * @since 9
+     */
+    readonly size: number;
+
+    /**
+     * Reads the next chunk, done is true at the end of the content.
+     * @param length The largest chunk in UTF-8 bytes, 64 KB by default and at most 256 KB.
+     * A chunk ends on a character boundary, so it can be shorter, or longer when length cannot hold
+     * the next character.
+     * @since 9
+     */
+    read(length?: number): Promise<{ value: string, done: boolean }>;
+    next(): Promise<{ value: string, done: boolean }>;
+
+    /**
+     * Closes the reader, it is also closed at the end of the content.
+     * @since 9
+     */
+    close(): void;
+  }
+
+  /**
+   * Writes a copy record by record in chunks, without building the whole data in memory.
+   * Nothing is published before commit, a writer that is dropped without commit is aborted.
+   * @since 9
+   */
+  interface PasteWriter {
+    /**
+     * Starts the next record, the first one added is the primary record. The content of a record
+     * must be written in full before the next record is added or the writer is committed.
+     * @param mimeType MIMETYPE_TEXT_PLAIN or MIMETYPE_TEXT_HTML.
+     * @param size Size of the content in UTF-8 bytes, below 500 KB.
+     * @since 9
+     */
+    addRecord(mimeType: string, size: number): Promise<void>;
+
+    /**
+     * Appends a chunk to the record being written, a chunk is rejected while another call is pending.
+     * @param chunk Text whose UTF-8 bytes are appended.
+     * @since 9
+     */
+    write(chunk: string): Promise<void>;
+
+    /**
+     * Publishes the records as the new paste data, rejected if a record is incomplete.
+     * The writer is closed either way.
+     * @since 9
+     */
+    commit(): Promise<void>;
+
+    /**
+     * Drops the writer and everything written to it.
+     * @since 9
+     */
+    abort(): Promise<void>;
+  }
+
   interface SystemPasteboard {
     /**
      * Callback invoked when pasteboard content changes.
      * @param type 'update'
      * @since 7
      */
-    on(type: 'update', callback: () => void): void;
+    on(type: 'update', callback: (event: PasteboardChangedEvent) => void): void;
+    /**
+     * Callback invoked when pasteboard content with one of the given MIME types changes.
+     * @param type 'update'
+     * @param mimeTypes Only changes involving at least one of these MIME types are reported.
+     * @since 9
+     */
+    on(type: 'update', mimeTypes: Array<string>, callback: (event: PasteboardChangedEvent) => void): void;
     /**
      * Callback invoked when pasteboard content changes.
      * @param type 'update'
      * @since 7
      */
-    off(type: 'update', callback?: () => void): void;
+    off(type: 'update', callback?: (event: PasteboardChangedEvent) => void): void;
 
     /**
      * Clears the pasteboard.
@@ -353,6 +468,35 @@ declare namespace pasteboard {
     hasPasteData(callback: AsyncCallback<boolean>): void;
     hasPasteData(): Promise<boolean>;
 
+    /**
+     * Gets the change count of the pasteboard, which is increased by every setPasteData and clear.
+     * Compare it with a previously read value to detect changes without reading the data.
+     * @return number The change count of the current user's pasteboard.
+     * @since 9
+     */
+    getChangeCount(callback: AsyncCallback<number>): void;
+    getChangeCount(): Promise<number>;
+
+    /**
+     * Opens a record of the pasteboard for reading its content in chunks, without reading the whole data.
+     * Opening a fifth reader closes the oldest one of the application.
+     * @param index The index to specify the content item.
+     * @return RecordReader The reader, rejected if there is no such record or the pasteboard has too many
+     * readers open.
+     * @since 9
+     */
+    openRecordReader(index: number, callback: AsyncCallback<RecordReader>): void;
+    openRecordReader(index: number): Promise<RecordReader>;
+
+    /**
+     * Begins a copy written record by record in chunks, for content too large to build as a PasteData.
+     * Beginning a third writer aborts the oldest one of the application, whose commit is then rejected.
+     * @return PasteWriter The writer, rejected if the pasteboard has too many writers open.
+     * @since 9
+     */
+    beginPasteWriter(callback: AsyncCallback<PasteWriter>): void;
+    beginPasteWriter(): Promise<PasteWriter>;
+
     /**
      * Writes PasteData to the pasteboard.
      * @param  data Containing the contents of the clipboard content object.
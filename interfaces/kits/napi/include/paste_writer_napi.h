@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef N_NAPI_PASTE_WRITER_H
+#define N_NAPI_PASTE_WRITER_H
+
+#include <cstdint>
+#include "napi/native_api.h"
+#include "napi/native_node_api.h"
+
+namespace OHOS {
+namespace MiscServicesNapi {
+struct PasteWriteContext;
+
+// Writes a copy record by record in chunks, the pasteboard publishes it on commit.
+class PasteWriterNapi {
+public:
+    static napi_value PasteWriterInit(napi_env env, napi_value exports);
+    static napi_value New(napi_env env, napi_callback_info info);
+    static napi_status NewInstance(napi_env env, napi_value &instance);
+    static void Destructor(napi_env env, void *nativeObject, void *finalize_hint);
+    PasteWriterNapi();
+    ~PasteWriterNapi();
+
+    uint32_t writerId_ = 0;
+
+private:
+    static napi_value AddRecord(napi_env env, napi_callback_info info);
+    static napi_value Write(napi_env env, napi_callback_info info);
+    static napi_value Commit(napi_env env, napi_callback_info info);
+    static napi_value Abort(napi_env env, napi_callback_info info);
+    static napi_value QueueWrite(napi_env env, napi_value thisVar, PasteWriteContext *context);
+
+    // Set while a call is on its way, chunks must arrive in order so a second call is refused meanwhile.
+    bool writing_ = false;
+    napi_env env_;
+    napi_ref wrapper_;
+};
+} // MiscServicesNapi
+} // OHOS
+#endif
@@ -15,6 +15,9 @@
 #ifndef N_NAPI_PASTEBOARD_COMMON_H
 #define N_NAPI_PASTEBOARD_COMMON_H
 
+#include <string>
+#include <vector>
+
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 
@@ -25,6 +28,8 @@ void SetCallback(const napi_env &env, const napi_ref &callbackIn, const int32_t
 napi_value NapiGetNull(napi_env env);
 napi_value CreateNapiNumber(napi_env env, int32_t num);
 napi_value CreateNapiString(napi_env env, std::string str);
+bool GetNapiString(napi_env env, napi_value value, std::string &str);
+bool GetNapiStringArray(napi_env env, napi_value value, std::vector<std::string> &strs);
 }  // namespace MiscServicesNapi
 }  // namespace OHOS
 #endif
\ No newline at end of file
@@ -15,6 +15,7 @@
 #ifndef N_NAPI_PASTEDATA_RECORD_H
 #define N_NAPI_PASTEDATA_RECORD_H
 
+#include <array>
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 #include "paste_data.h"
@@ -32,8 +33,8 @@ public:
     static void Destructor(napi_env env, void *nativeObject, void *finalize_hint);
     static bool NewInstanceByRecord(
         napi_env env, napi_value &instance, const std::shared_ptr<MiscServices::PasteDataRecord> &record);
-    static bool NewHtmlTextRecordInstance(napi_env env, const std::string &text, napi_value &instance);
-    static bool NewPlainTextRecordInstance(napi_env env, const std::string &text, napi_value &instance);
+    static bool NewHtmlTextRecordInstance(napi_env env, std::string &&text, napi_value &instance);
+    static bool NewPlainTextRecordInstance(napi_env env, std::string &&text, napi_value &instance);
     static bool NewUriRecordInstance(napi_env env, const std::string &text, napi_value &instance);
     static bool NewWantRecordInstance(
         napi_env env, const std::shared_ptr<OHOS::AAFwk::Want> want, napi_value &instance);
@@ -46,7 +47,15 @@ public:
     std::shared_ptr<MiscServices::PasteDataRecord> value_;
 
 private:
+    // Sets the payload property of a builtin record type, indexed by mime type id.
+    using FillFunc = void (PasteDataRecordNapi::*)(napi_env env, napi_value &instance);
+    static const std::array<FillFunc, MiscServices::MIME_ID_BUILTIN_COUNT> fillFuncs_;
+
     bool JSFillInstance(napi_env env, napi_value &instance);
+    void FillHtmlText(napi_env env, napi_value &instance);
+    void FillPlainText(napi_env env, napi_value &instance);
+    void FillUri(napi_env env, napi_value &instance);
+    void FillWant(napi_env env, napi_value &instance);
     void SetNamedPropertyByStr(napi_env env, napi_value &dstObj, const std::string &objName, const char *propName);
     napi_env env_;
     napi_ref wrapper_;
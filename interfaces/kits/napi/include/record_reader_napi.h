@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef N_NAPI_RECORD_READER_H
+#define N_NAPI_RECORD_READER_H
+
+#include <cstdint>
+#include <string>
+#include "napi/native_api.h"
+#include "napi/native_node_api.h"
+
+namespace OHOS {
+namespace MiscServicesNapi {
+// Reads the content of one pasteboard record in chunks, and is its own async iterator.
+class RecordReaderNapi {
+public:
+    static napi_value RecordReaderInit(napi_env env, napi_value exports);
+    static napi_value New(napi_env env, napi_callback_info info);
+    static napi_status NewInstance(napi_env env, napi_value &instance);
+    static void Destructor(napi_env env, void *nativeObject, void *finalize_hint);
+    RecordReaderNapi();
+    ~RecordReaderNapi();
+
+    uint32_t readerId_ = 0;
+    uint64_t offset_ = 0;
+
+private:
+    static napi_value Read(napi_env env, napi_callback_info info);
+    static napi_value Close(napi_env env, napi_callback_info info);
+    static napi_value GetAsyncIterator(napi_env env, napi_callback_info info);
+    static napi_value CreateIteratorResult(napi_env env, const std::string *value);
+
+    // Set while a read is on its way, chunks follow each other so a second read is refused meanwhile.
+    bool reading_ = false;
+    napi_env env_;
+    napi_ref wrapper_;
+};
+} // MiscServicesNapi
+} // OHOS
+#endif
@@ -32,8 +32,10 @@ public:
     ~PasteboardObserverInstance();
 
     virtual void OnPasteboardChanged() override;
+    virtual void OnPasteboardChanged(const MiscServices::PasteboardChangedEvent &event) override;
     void setOff();
 private:
+    void QueueOnPasteboardChanged(std::shared_ptr<MiscServices::PasteboardChangedEvent> event);
     napi_env env_ = nullptr;
     napi_ref ref_ = nullptr;
     bool isOff_;
@@ -43,6 +45,7 @@ struct PasteboardDataWorker {
     napi_env env = nullptr;
     napi_ref ref = nullptr;
     bool isOff_;
+    std::shared_ptr<MiscServices::PasteboardChangedEvent> event;
 };
 
 class SystemPasteboardNapi {
@@ -62,6 +65,9 @@ private:
     static napi_value GetPasteData(napi_env env, napi_callback_info info);
     static napi_value SetPasteData(napi_env env, napi_callback_info info);
     static napi_value HasPasteData(napi_env env, napi_callback_info info);
+    static napi_value GetChangeCount(napi_env env, napi_callback_info info);
+    static napi_value OpenRecordReader(napi_env env, napi_callback_info info);
+    static napi_value BeginPasteWriter(napi_env env, napi_callback_info info);
     static std::shared_ptr<PasteboardObserverInstance> GetPasteboardObserverIns(const napi_ref &ref);
 
     std::shared_ptr<PasteDataNapi> value_;
@@ -13,8 +13,10 @@
  * limitations under the License.
  */
 #include "napi_init.h"
+#include "paste_writer_napi.h"
 #include "pastedata_napi.h"
 #include "pastedata_record_napi.h"
+#include "record_reader_napi.h"
 #include "systempasteboard_napi.h"
 
 namespace OHOS {
@@ -30,6 +32,8 @@ static napi_value NapiInit(napi_env env, napi_value exports)
      */
     PasteDataRecordNapi::PasteDataRecordInit(env, exports);
     PasteDataNapi::PasteDataInit(env, exports);
+    RecordReaderNapi::RecordReaderInit(env, exports);
+    PasteWriterNapi::PasteWriterInit(env, exports);
     SystemPasteboardNapi::SystemPasteboardInit(env, exports);
     PasteBoardInit(env, exports);
     return exports;
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "paste_writer_napi.h"
+
+#include <new>
+#include <string>
+#include <utility>
+#include "napi_common.h"
+#include "pasteboard_client.h"
+#include "pasteboard_common.h"
+#include "pasteboard_hilog_wreapper.h"
+
+using namespace OHOS::MiscServices;
+
+namespace OHOS {
+namespace MiscServicesNapi {
+namespace {
+thread_local napi_ref g_pasteWriter = nullptr;
+const size_t ARGC_TYPE_SET1 = 1;
+const size_t ARGC_TYPE_SET2 = 2;
+}
+
+enum class PasteWriteOp : uint32_t {
+    ADD_RECORD,
+    WRITE,
+    COMMIT,
+    ABORT,
+};
+
+struct PasteWriteContext {
+    napi_env env = nullptr;
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref thisRef = nullptr;
+    PasteWriterNapi *obj = nullptr;
+    PasteWriteOp op = PasteWriteOp::WRITE;
+    uint32_t writerId = 0;
+    std::string mimeType;
+    uint64_t size = 0;
+    std::string chunk;
+    bool ok = false;
+};
+
+PasteWriterNapi::PasteWriterNapi() : env_(nullptr), wrapper_(nullptr)
+{
+}
+
+PasteWriterNapi::~PasteWriterNapi()
+{
+    if (writerId_ != 0) {
+        // dropped without commit, nothing of it is published
+        PasteboardClient::GetInstance()->AbortPasteWriter(writerId_);
+    }
+    napi_delete_reference(env_, wrapper_);
+}
+
+napi_value PasteWriterNapi::QueueWrite(napi_env env, napi_value thisVar, PasteWriteContext *context)
+{
+    PasteWriterNapi *obj = context->obj;
+    napi_value promise = nullptr;
+    napi_create_promise(env, &context->deferred, &promise);
+    context->writerId = obj->writerId_;
+    if (context->op == PasteWriteOp::COMMIT || context->op == PasteWriteOp::ABORT) {
+        // the writer is closed by either, the destructor must not abort it again
+        obj->writerId_ = 0;
+    }
+    if (context->writerId == 0) {
+        // committed, aborted or failed to begin, aborting it again is harmless
+        if (context->op == PasteWriteOp::ABORT) {
+            napi_resolve_deferred(env, context->deferred, NapiGetNull(env));
+        } else {
+            napi_reject_deferred(env, context->deferred, GetCallbackErrorValue(env, -1));
+        }
+        delete context;
+        return promise;
+    }
+    napi_create_reference(env, thisVar, 1, &context->thisRef);
+
+    napi_value resource = nullptr;
+    napi_create_string_latin1(env, "PasteWriterWork", NAPI_AUTO_LENGTH, &resource);
+    napi_status asyncWork = napi_create_async_work(env,
+        nullptr,
+        resource,
+        [](napi_env env, void *data) {
+            PasteWriteContext *context = (PasteWriteContext *)data;
+            auto client = PasteboardClient::GetInstance();
+            switch (context->op) {
+                case PasteWriteOp::ADD_RECORD:
+                    context->ok = client->AddWriterRecord(context->writerId, context->mimeType, context->size);
+                    break;
+                case PasteWriteOp::WRITE:
+                    context->ok = client->WriteRecordChunk(context->writerId, context->chunk.data(),
+                        context->chunk.size());
+                    break;
+                case PasteWriteOp::COMMIT:
+                    context->ok = client->CommitPasteWriter(context->writerId);
+                    break;
+                case PasteWriteOp::ABORT:
+                    client->AbortPasteWriter(context->writerId);
+                    context->ok = true;
+                    break;
+            }
+        },
+        [](napi_env env, napi_status status, void *data) {
+            PasteWriteContext *context = (PasteWriteContext *)data;
+            context->obj->writing_ = false;
+            if (context->ok) {
+                napi_resolve_deferred(env, context->deferred, NapiGetNull(env));
+            } else {
+                napi_reject_deferred(env, context->deferred, GetCallbackErrorValue(env, -1));
+            }
+            napi_delete_reference(env, context->thisRef);
+            napi_delete_async_work(env, context->work);
+            delete context;
+        },
+        (void *)context, &context->work);
+    if (asyncWork != napi_ok) {
+        if (context->op == PasteWriteOp::COMMIT || context->op == PasteWriteOp::ABORT) {
+            PasteboardClient::GetInstance()->AbortPasteWriter(context->writerId);
+        }
+        napi_delete_reference(env, context->thisRef);
+        delete context;
+        return NapiGetNull(env);
+    }
+    obj->writing_ = true;
+    napi_queue_async_work(env, context->work);
+    return promise;
+}
+
+napi_value PasteWriterNapi::AddRecord(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGC_TYPE_SET2;
+    napi_value argv[ARGC_TYPE_SET2] = {0};
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr));
+    NAPI_ASSERT(env, argc >= ARGC_TYPE_SET2, "Wrong number of arguments");
+    PasteWriterNapi *obj = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisVar, reinterpret_cast<void **>(&obj)));
+    NAPI_ASSERT(env, obj != nullptr, "Wrong object.");
+    std::string mimeType;
+    NAPI_ASSERT(env, GetNapiString(env, argv[0], mimeType), "Wrong argument type. String expected.");
+    napi_valuetype valueType = napi_undefined;
+    NAPI_CALL(env, napi_typeof(env, argv[1], &valueType));
+    NAPI_ASSERT(env, valueType == napi_number, "Wrong argument type. Number expected.");
+    int64_t size = 0;
+    NAPI_CALL(env, napi_get_value_int64(env, argv[1], &size));
+    NAPI_ASSERT(env, size >= 0, "Wrong argument. Size must not be negative.");
+    NAPI_ASSERT(env, !obj->writing_, "Another write is pending.");
+
+    PasteWriteContext *context = new (std::nothrow) PasteWriteContext {.env = env, .work = nullptr};
+    if (context == nullptr) {
+        return NapiGetNull(env);
+    }
+    context->obj = obj;
+    context->op = PasteWriteOp::ADD_RECORD;
+    context->mimeType = std::move(mimeType);
+    context->size = static_cast<uint64_t>(size);
+    return QueueWrite(env, thisVar, context);
+}
+
+napi_value PasteWriterNapi::Write(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGC_TYPE_SET1;
+    napi_value argv[ARGC_TYPE_SET1] = {0};
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr));
+    NAPI_ASSERT(env, argc >= ARGC_TYPE_SET1, "Wrong number of arguments");
+    PasteWriterNapi *obj = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisVar, reinterpret_cast<void **>(&obj)));
+    NAPI_ASSERT(env, obj != nullptr, "Wrong object.");
+    std::string chunk;
+    NAPI_ASSERT(env, GetNapiString(env, argv[0], chunk), "Wrong argument type. String expected.");
+    NAPI_ASSERT(env, !obj->writing_, "Another write is pending.");
+
+    PasteWriteContext *context = new (std::nothrow) PasteWriteContext {.env = env, .work = nullptr};
+    if (context == nullptr) {
+        return NapiGetNull(env);
+    }
+    context->obj = obj;
+    context->op = PasteWriteOp::WRITE;
+    context->chunk = std::move(chunk);
+    return QueueWrite(env, thisVar, context);
+}
+
+napi_value PasteWriterNapi::Commit(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr));
+    PasteWriterNapi *obj = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisVar, reinterpret_cast<void **>(&obj)));
+    NAPI_ASSERT(env, obj != nullptr, "Wrong object.");
+    NAPI_ASSERT(env, !obj->writing_, "Another write is pending.");
+
+    PasteWriteContext *context = new (std::nothrow) PasteWriteContext {.env = env, .work = nullptr};
+    if (context == nullptr) {
+        return NapiGetNull(env);
+    }
+    context->obj = obj;
+    context->op = PasteWriteOp::COMMIT;
+    return QueueWrite(env, thisVar, context);
+}
+
+napi_value PasteWriterNapi::Abort(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr));
+    PasteWriterNapi *obj = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisVar, reinterpret_cast<void **>(&obj)));
+    NAPI_ASSERT(env, obj != nullptr, "Wrong object.");
+    NAPI_ASSERT(env, !obj->writing_, "Another write is pending.");
+
+    PasteWriteContext *context = new (std::nothrow) PasteWriteContext {.env = env, .work = nullptr};
+    if (context == nullptr) {
+        return NapiGetNull(env);
+    }
+    context->obj = obj;
+    context->op = PasteWriteOp::ABORT;
+    return QueueWrite(env, thisVar, context);
+}
+
+napi_value PasteWriterNapi::PasteWriterInit(napi_env env, napi_value exports)
+{
+    napi_property_descriptor properties[] = {
+        DECLARE_NAPI_FUNCTION("addRecord", AddRecord),
+        DECLARE_NAPI_FUNCTION("write", Write),
+        DECLARE_NAPI_FUNCTION("commit", Commit),
+        DECLARE_NAPI_FUNCTION("abort", Abort),
+    };
+
+    napi_value constructor;
+    napi_status status = napi_define_class(env,
+        "PasteWriter",
+        NAPI_AUTO_LENGTH,
+        New,
+        nullptr,
+        sizeof(properties) / sizeof(napi_property_descriptor),
+        properties,
+        &constructor);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Failed to define class at PasteWriterInit");
+        return nullptr;
+    }
+
+    status = napi_create_reference(env, constructor, 1, &g_pasteWriter);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "PasteWriterInit create referece failed");
+        return nullptr;
+    }
+    return exports;
+}
+
+void PasteWriterNapi::Destructor(napi_env env, void *nativeObject, void *finalize_hint)
+{
+    PasteWriterNapi *obj = static_cast<PasteWriterNapi *>(nativeObject);
+    delete obj;
+}
+
+napi_value PasteWriterNapi::New(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+
+    PasteWriterNapi *obj = new (std::nothrow) PasteWriterNapi();
+    if (obj == nullptr) {
+        return nullptr;
+    }
+    obj->env_ = env;
+    NAPI_CALL(env, napi_wrap(env, thisVar, obj, PasteWriterNapi::Destructor, nullptr, &obj->wrapper_));
+    return thisVar;
+}
+
+napi_status PasteWriterNapi::NewInstance(napi_env env, napi_value &instance)
+{
+    napi_value constructor;
+    napi_status status = napi_get_reference_value(env, g_pasteWriter, &constructor);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "get referece failed");
+        return status;
+    }
+    status = napi_new_instance(env, constructor, 0, nullptr, &instance);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "new instance failed");
+        return status;
+    }
+    return napi_ok;
+}
+} // namespace MiscServicesNapi
+} // namespace OHOS
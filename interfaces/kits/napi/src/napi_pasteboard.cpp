@@ -17,6 +17,8 @@
 #include "pasteboard_common.h"
 #include "napi_common.h"
 #include "pasteboard_hilog_wreapper.h"
+#include "paste_writer_napi.h"
+#include "record_reader_napi.h"
 
 using namespace OHOS::MiscServices;
 
@@ -27,6 +29,7 @@ std::mutex SystemPasteboardNapi::pasteboardObserverInsMutex_;
 std::map<napi_ref, std::shared_ptr<PasteboardObserverInstance>> SystemPasteboardNapi::observers_;
 const size_t ARGC_TYPE_SET1 = 1;
 const size_t ARGC_TYPE_SET2 = 2;
+const size_t ARGC_TYPE_SET3 = 3;
 const int32_t STR_DATA_SIZE = 10;
 const std::string STRING_UPDATE = "update";
 
@@ -42,6 +45,28 @@ void PasteboardObserverInstance::setOff()
     isOff_ = true;
 }
 
+napi_value CreateChangedEvent(napi_env env, const PasteboardChangedEvent &event)
+{
+    napi_value result = nullptr;
+    NAPI_CALL(env, napi_create_object(env, &result));
+    napi_value value = nullptr;
+    NAPI_CALL(env, napi_create_int64(env, static_cast<int64_t>(event.seq), &value));
+    NAPI_CALL(env, napi_set_named_property(env, result, "seq", value));
+    NAPI_CALL(env, napi_create_array_with_length(env, event.mimeTypes.size(), &value));
+    for (uint32_t i = 0; i < event.mimeTypes.size(); ++i) {
+        NAPI_CALL(env, napi_set_element(env, value, i, CreateNapiString(env, event.mimeTypes[i])));
+    }
+    NAPI_CALL(env, napi_set_named_property(env, result, "mimeTypes", value));
+    NAPI_CALL(env, napi_create_uint32(env, event.recordCount, &value));
+    NAPI_CALL(env, napi_set_named_property(env, result, "recordCount", value));
+    NAPI_CALL(env, napi_create_int64(env, static_cast<int64_t>(event.totalBytes), &value));
+    NAPI_CALL(env, napi_set_named_property(env, result, "totalBytes", value));
+    NAPI_CALL(env, napi_set_named_property(env, result, "bundleName", CreateNapiString(env, event.bundleName)));
+    NAPI_CALL(env, napi_create_int64(env, event.timestamp, &value));
+    NAPI_CALL(env, napi_set_named_property(env, result, "timestamp", value));
+    return result;
+}
+
 void UvQueueWorkOnPasteboardChanged(uv_work_t *work, int status)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "UvQueueWorkOnPasteboardChanged start");
@@ -68,8 +93,13 @@ void UvQueueWorkOnPasteboardChanged(uv_work_t *work, int status)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "pasteboardDataWorker ref = %{public}p", pasteboardDataWorker->ref);
     napi_get_reference_value(pasteboardDataWorker->env, pasteboardDataWorker->ref, &callback);
     napi_value result = NapiGetNull(pasteboardDataWorker->env);
+    size_t argc = 0;
+    if (pasteboardDataWorker->event != nullptr) {
+        result = CreateChangedEvent(pasteboardDataWorker->env, *pasteboardDataWorker->event);
+        argc = (result == nullptr) ? 0 : ARGC_TYPE_SET1;
+    }
     napi_call_function(
-        pasteboardDataWorker->env, undefined, callback, 0, &result, &resultout);
+        pasteboardDataWorker->env, undefined, callback, argc, &result, &resultout);
 
     delete pasteboardDataWorker;
     pasteboardDataWorker = nullptr;
@@ -79,6 +109,17 @@ void UvQueueWorkOnPasteboardChanged(uv_work_t *work, int status)
 void PasteboardObserverInstance::OnPasteboardChanged()
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "OnPasteboardChanged is called!");
+    QueueOnPasteboardChanged(nullptr);
+}
+
+void PasteboardObserverInstance::OnPasteboardChanged(const PasteboardChangedEvent &event)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "OnPasteboardChanged with event is called!");
+    QueueOnPasteboardChanged(std::make_shared<PasteboardChangedEvent>(event));
+}
+
+void PasteboardObserverInstance::QueueOnPasteboardChanged(std::shared_ptr<PasteboardChangedEvent> event)
+{
     uv_loop_s *loop = nullptr;
     napi_get_uv_event_loop(env_, &loop);
     if (loop == nullptr) {
@@ -101,6 +142,7 @@ void PasteboardObserverInstance::OnPasteboardChanged()
     pasteboardDataWorker->env = env_;
     pasteboardDataWorker->ref = ref_;
     pasteboardDataWorker->isOff_ = isOff_;
+    pasteboardDataWorker->event = std::move(event);
 
     work->data = (void *)pasteboardDataWorker;
 
@@ -127,21 +169,12 @@ napi_value JScreateHtmlTextRecord(napi_env env, napi_callback_info info)
     NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
     NAPI_ASSERT(env, valueType == napi_string, "Wrong argument type. String expected.");
     
-    size_t len = 0;
-    napi_status status = napi_get_value_string_utf8(env, argv[0], nullptr, 0, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get length failed");
-        return nullptr;
-    }
-    std::vector<char> buf(len + 1);
-    status = napi_get_value_string_utf8(env, argv[0], buf.data(), len + 1, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get data failed");
+    std::string str;
+    if (!GetNapiString(env, argv[0], str)) {
         return nullptr;
     }
-    std::string str(buf.data());
     napi_value instance = nullptr;
-    PasteDataRecordNapi::NewHtmlTextRecordInstance(env, str, instance);
+    PasteDataRecordNapi::NewHtmlTextRecordInstance(env, std::move(str), instance);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "end.");
     return instance;
 }
@@ -185,23 +218,13 @@ napi_value JScreatePlainTextRecord(napi_env env, napi_callback_info info)
     NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
     NAPI_ASSERT(env, valueType == napi_string, "Wrong argument type. String expected.");
 
-    size_t len = 0;
-    napi_status status = napi_get_value_string_utf8(env, argv[0], nullptr, 0, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get length failed");
+    std::string str;
+    if (!GetNapiString(env, argv[0], str)) {
         return nullptr;
     }
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "ddd.");
-    std::vector<char> buf(len + 1);
-    status = napi_get_value_string_utf8(env, argv[0], buf.data(), len + 1, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get data failed");
-        return nullptr;
-    }
-    std::string str(buf.data());
     napi_value instance = nullptr;
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "eee.");
-    PasteDataRecordNapi::NewPlainTextRecordInstance(env, str, instance);
+    PasteDataRecordNapi::NewPlainTextRecordInstance(env, std::move(str), instance);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "end.");
     return instance;
 }
@@ -248,27 +271,18 @@ napi_value JScreateHtmlData(napi_env env, napi_callback_info info)
     napi_valuetype valueType = napi_undefined;
     NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
     NAPI_ASSERT(env, valueType == napi_string, "Wrong argument type. String expected.");
-    size_t len = 0;
-    napi_status status = napi_get_value_string_utf8(env, argv[0], nullptr, 0, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get length failed");
-        return nullptr;
-    }
-    std::vector<char> buf(len + 1);
-    status = napi_get_value_string_utf8(env, argv[0], buf.data(), len + 1, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get data failed");
+    std::string str;
+    if (!GetNapiString(env, argv[0], str)) {
         return nullptr;
     }
-    std::string str(buf.data());
     napi_value instance = nullptr;
     NAPI_CALL(env, PasteDataNapi::NewInstance(env, instance));
     PasteDataNapi *obj = nullptr;
-    status = napi_unwrap(env, instance, reinterpret_cast<void **>(&obj));
+    napi_status status = napi_unwrap(env, instance, reinterpret_cast<void **>(&obj));
     if ((status != napi_ok) || (obj == nullptr)) {
         return nullptr;
     }
-    obj->value_ = PasteboardClient::GetInstance()->CreateHtmlData(str);
+    obj->value_ = PasteboardClient::GetInstance()->CreateHtmlData(std::move(str));
 
     return instance;
 }
@@ -313,27 +327,18 @@ napi_value JScreatePlainTextData(napi_env env, napi_callback_info info)
     napi_valuetype valueType = napi_undefined;
     NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
     NAPI_ASSERT(env, valueType == napi_string, "Wrong argument type. String expected.");
-    size_t len = 0;
-    napi_status status = napi_get_value_string_utf8(env, argv[0], nullptr, 0, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get JScreatePlainTextData length failed");
-        return nullptr;
-    }
-    std::vector<char> buf(len + 1);
-    status = napi_get_value_string_utf8(env, argv[0], buf.data(), len + 1, &len);
-    if (status != napi_ok) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get JScreatePlainTextData data failed");
+    std::string str;
+    if (!GetNapiString(env, argv[0], str)) {
         return nullptr;
     }
-    std::string str(buf.data());
     napi_value instance = nullptr;
     NAPI_CALL(env, PasteDataNapi::NewInstance(env, instance));
     PasteDataNapi *obj = nullptr;
-    status = napi_unwrap(env, instance, reinterpret_cast<void **>(&obj));
+    napi_status status = napi_unwrap(env, instance, reinterpret_cast<void **>(&obj));
     if ((status != napi_ok) || (obj == nullptr)) {
         return nullptr;
     }
-    obj->value_ = PasteboardClient::GetInstance()->CreatePlainTextData(str);
+    obj->value_ = PasteboardClient::GetInstance()->CreatePlainTextData(std::move(str));
 
     return instance;
 }
@@ -422,13 +427,14 @@ using AsyncContext = struct AsyncContext {
     napi_ref callbackRef = nullptr;
     PasteDataNapi *obj = nullptr;
     int32_t status = 0;
+    int64_t changeCount = 0;
 };
 
 napi_value SystemPasteboardNapi::On(napi_env env, napi_callback_info info)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "SystemPasteboardNapi on() is called!");
-    size_t argc = ARGC_TYPE_SET2;
-    napi_value argv[ARGC_TYPE_SET2] = { 0 };
+    size_t argc = ARGC_TYPE_SET3;
+    napi_value argv[ARGC_TYPE_SET3] = { 0 };
     napi_value thisVar = 0;
     void *data = nullptr;
     napi_get_cb_info(env, info, &argc, argv, &thisVar, &data);
@@ -442,13 +448,21 @@ napi_value SystemPasteboardNapi::On(napi_env env, napi_callback_info info)
     NAPI_CALL(env, napi_get_value_string_utf8(env, argv[0], str, STR_DATA_SIZE, &strLen));
     NAPI_ASSERT(env, strLen == STRING_UPDATE.length(), "error type");
 
-    napi_typeof(env, argv[ARGC_TYPE_SET1], &valueType);
+    // on('update', callback) or on('update', mimeTypes, callback)
+    std::vector<std::string> mimeTypes;
+    size_t callbackIndex = ARGC_TYPE_SET1;
+    if (argc >= ARGC_TYPE_SET3) {
+        NAPI_ASSERT(env, GetNapiStringArray(env, argv[ARGC_TYPE_SET1], mimeTypes),
+            "Wrong argument type. Array<string> expected.");
+        callbackIndex = ARGC_TYPE_SET2;
+    }
+    napi_typeof(env, argv[callbackIndex], &valueType);
     NAPI_ASSERT(env, valueType == napi_function, "Wrong argument type. Function expected.");
 
     napi_ref ref = nullptr;
-    napi_create_reference(env, argv[ARGC_TYPE_SET1], 1, &ref);
+    napi_create_reference(env, argv[callbackIndex], 1, &ref);
     auto observer = std::make_shared<PasteboardObserverInstance>(env, ref);
-    PasteboardClient::GetInstance()->AddPasteboardChangedObserver(observer);
+    PasteboardClient::GetInstance()->AddPasteboardChangedObserver(observer, mimeTypes);
     std::lock_guard<std::mutex> lock(pasteboardObserverInsMutex_);
     observers_[ref] = observer;
     napi_value result = nullptr;
@@ -627,6 +641,174 @@ napi_value SystemPasteboardNapi::HasPasteData(napi_env env, napi_callback_info i
     return promise;
 }
 
+napi_value SystemPasteboardNapi::GetChangeCount(napi_env env, napi_callback_info info)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "GetChangeCount is called!");
+    size_t argc = ARGC_TYPE_SET1;
+    napi_value argv[ARGC_TYPE_SET1] = {0};
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, NULL));
+
+    AsyncContext *asyncContext = new (std::nothrow) AsyncContext {.env = env, .work = nullptr};
+    if (!asyncContext) {
+        return NapiGetNull(env);
+    }
+
+    if (argc >= ARGC_TYPE_SET1) {
+        napi_valuetype valueType = napi_undefined;
+        NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
+        NAPI_ASSERT(env, valueType == napi_function, "Wrong argument type. Function expected.");
+        napi_create_reference(env, argv[0], 1, &asyncContext->callbackRef);
+    }
+
+    napi_value promise = nullptr;
+    if (asyncContext->callbackRef == nullptr) {
+        napi_create_promise(env, &asyncContext->deferred, &promise);
+    } else {
+        napi_get_undefined(env, &promise);
+    }
+
+    napi_value resource = nullptr;
+    napi_create_string_latin1(env, "GetChangeCount", NAPI_AUTO_LENGTH, &resource);
+    napi_status asyncWork = napi_create_async_work(env,
+        nullptr,
+        resource,
+        [](napi_env env, void* data) {
+            AsyncContext* asyncContext = (AsyncContext*)data;
+            asyncContext->changeCount = PasteboardClient::GetInstance()->GetChangeCount();
+            asyncContext->status = (asyncContext->changeCount < 0) ? -1 : 0;
+        },
+        [](napi_env env, napi_status status, void* data) {
+            AsyncContext* asyncContext = (AsyncContext*)data;
+            napi_value result = nullptr;
+            napi_create_int64(env, asyncContext->changeCount, &result);
+            if (asyncContext->deferred) {
+                if (!asyncContext->status) {
+                    napi_resolve_deferred(env, asyncContext->deferred, result);
+                } else {
+                    napi_reject_deferred(env, asyncContext->deferred, result);
+                }
+            } else {
+                SetCallback(env, asyncContext->callbackRef, asyncContext->status, result);
+                napi_delete_reference(env, asyncContext->callbackRef);
+            }
+            napi_delete_async_work(env, asyncContext->work);
+            delete asyncContext;
+            asyncContext = nullptr;
+        },
+        (void*)asyncContext, &asyncContext->work);
+    napi_queue_async_work(env, asyncContext->work);
+    if (asyncWork != napi_ok) {
+        delete asyncContext;
+        asyncContext = nullptr;
+    }
+
+    return promise;
+}
+
+using OpenReaderContext = struct OpenReaderContext {
+    napi_env env = nullptr;
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref callbackRef = nullptr;
+    uint32_t index = 0;
+    uint32_t readerId = 0;
+    std::string mimeType;
+    uint64_t size = 0;
+};
+
+napi_value CreateRecordReader(napi_env env, OpenReaderContext &context)
+{
+    napi_value instance = nullptr;
+    RecordReaderNapi *obj = nullptr;
+    if (RecordReaderNapi::NewInstance(env, instance) != napi_ok ||
+        napi_unwrap(env, instance, reinterpret_cast<void **>(&obj)) != napi_ok || obj == nullptr) {
+        return nullptr;
+    }
+    // the instance closes the reader from now on
+    obj->readerId_ = context.readerId;
+    context.readerId = 0;
+    napi_value size = nullptr;
+    NAPI_CALL(env, napi_create_int64(env, static_cast<int64_t>(context.size), &size));
+    NAPI_CALL(env, napi_set_named_property(env, instance, "size", size));
+    NAPI_CALL(env, napi_set_named_property(env, instance, "mimeType", CreateNapiString(env, context.mimeType)));
+    return instance;
+}
+
+napi_value SystemPasteboardNapi::OpenRecordReader(napi_env env, napi_callback_info info)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "OpenRecordReader is called!");
+    size_t argc = ARGC_TYPE_SET2;
+    napi_value argv[ARGC_TYPE_SET2] = {0};
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, NULL));
+    NAPI_ASSERT(env, argc >= ARGC_TYPE_SET1, "Wrong number of arguments");
+    napi_valuetype valueType = napi_undefined;
+    NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
+    NAPI_ASSERT(env, valueType == napi_number, "Wrong argument type. Number expected.");
+
+    OpenReaderContext *asyncContext = new (std::nothrow) OpenReaderContext {.env = env, .work = nullptr};
+    if (!asyncContext) {
+        return NapiGetNull(env);
+    }
+    napi_get_value_uint32(env, argv[0], &asyncContext->index);
+    if (argc >= ARGC_TYPE_SET2) {
+        NAPI_CALL(env, napi_typeof(env, argv[1], &valueType));
+        NAPI_ASSERT(env, valueType == napi_function, "Wrong argument type. Function expected.");
+        napi_create_reference(env, argv[1], 1, &asyncContext->callbackRef);
+    }
+
+    napi_value promise = nullptr;
+    if (asyncContext->callbackRef == nullptr) {
+        napi_create_promise(env, &asyncContext->deferred, &promise);
+    } else {
+        napi_get_undefined(env, &promise);
+    }
+
+    napi_value resource = nullptr;
+    napi_create_string_latin1(env, "OpenRecordReader", NAPI_AUTO_LENGTH, &resource);
+    napi_status asyncWork = napi_create_async_work(env,
+        nullptr,
+        resource,
+        [](napi_env env, void *data) {
+            OpenReaderContext *asyncContext = (OpenReaderContext *)data;
+            asyncContext->readerId = PasteboardClient::GetInstance()->OpenRecordReader(asyncContext->index,
+                asyncContext->mimeType, asyncContext->size);
+        },
+        [](napi_env env, napi_status status, void *data) {
+            OpenReaderContext *asyncContext = (OpenReaderContext *)data;
+            napi_value result = (asyncContext->readerId == 0) ? nullptr : CreateRecordReader(env, *asyncContext);
+            int32_t errorCode = (result == nullptr) ? -1 : 0;
+            if (asyncContext->readerId != 0) {
+                PasteboardClient::GetInstance()->CloseRecordReader(asyncContext->readerId);
+            }
+            if (result == nullptr) {
+                result = NapiGetNull(env);
+            }
+            if (asyncContext->deferred) {
+                if (!errorCode) {
+                    napi_resolve_deferred(env, asyncContext->deferred, result);
+                } else {
+                    napi_reject_deferred(env, asyncContext->deferred, result);
+                }
+            } else {
+                SetCallback(env, asyncContext->callbackRef, errorCode, result);
+                napi_delete_reference(env, asyncContext->callbackRef);
+            }
+            napi_delete_async_work(env, asyncContext->work);
+            delete asyncContext;
+            asyncContext = nullptr;
+        },
+        (void *)asyncContext, &asyncContext->work);
+    napi_queue_async_work(env, asyncContext->work);
+    if (asyncWork != napi_ok) {
+        delete asyncContext;
+        asyncContext = nullptr;
+    }
+
+    return promise;
+}
+
 napi_value SystemPasteboardNapi::GetPasteData(napi_env env, napi_callback_info info)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "GetPasteData is called!");
@@ -779,6 +961,97 @@ napi_value SystemPasteboardNapi::SetPasteData(napi_env env, napi_callback_info i
     return promise;
 }
 
+using BeginWriterContext = struct BeginWriterContext {
+    napi_env env = nullptr;
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref callbackRef = nullptr;
+    uint32_t writerId = 0;
+};
+
+napi_value CreatePasteWriter(napi_env env, BeginWriterContext &context)
+{
+    napi_value instance = nullptr;
+    PasteWriterNapi *obj = nullptr;
+    if (PasteWriterNapi::NewInstance(env, instance) != napi_ok ||
+        napi_unwrap(env, instance, reinterpret_cast<void **>(&obj)) != napi_ok || obj == nullptr) {
+        return nullptr;
+    }
+    // the instance aborts the writer from now on unless it is committed
+    obj->writerId_ = context.writerId;
+    context.writerId = 0;
+    return instance;
+}
+
+napi_value SystemPasteboardNapi::BeginPasteWriter(napi_env env, napi_callback_info info)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_JS_NAPI, "BeginPasteWriter is called!");
+    size_t argc = ARGC_TYPE_SET1;
+    napi_value argv[ARGC_TYPE_SET1] = {0};
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, NULL));
+
+    BeginWriterContext *asyncContext = new (std::nothrow) BeginWriterContext {.env = env, .work = nullptr};
+    if (!asyncContext) {
+        return NapiGetNull(env);
+    }
+    if (argc >= ARGC_TYPE_SET1) {
+        napi_valuetype valueType = napi_undefined;
+        NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
+        NAPI_ASSERT(env, valueType == napi_function, "Wrong argument type. Function expected.");
+        napi_create_reference(env, argv[0], 1, &asyncContext->callbackRef);
+    }
+
+    napi_value promise = nullptr;
+    if (asyncContext->callbackRef == nullptr) {
+        napi_create_promise(env, &asyncContext->deferred, &promise);
+    } else {
+        napi_get_undefined(env, &promise);
+    }
+
+    napi_value resource = nullptr;
+    napi_create_string_latin1(env, "BeginPasteWriter", NAPI_AUTO_LENGTH, &resource);
+    napi_status asyncWork = napi_create_async_work(env,
+        nullptr,
+        resource,
+        [](napi_env env, void *data) {
+            BeginWriterContext *asyncContext = (BeginWriterContext *)data;
+            asyncContext->writerId = PasteboardClient::GetInstance()->BeginPasteWriter();
+        },
+        [](napi_env env, napi_status status, void *data) {
+            BeginWriterContext *asyncContext = (BeginWriterContext *)data;
+            napi_value result = (asyncContext->writerId == 0) ? nullptr : CreatePasteWriter(env, *asyncContext);
+            int32_t errorCode = (result == nullptr) ? -1 : 0;
+            if (asyncContext->writerId != 0) {
+                PasteboardClient::GetInstance()->AbortPasteWriter(asyncContext->writerId);
+            }
+            if (result == nullptr) {
+                result = NapiGetNull(env);
+            }
+            if (asyncContext->deferred) {
+                if (!errorCode) {
+                    napi_resolve_deferred(env, asyncContext->deferred, result);
+                } else {
+                    napi_reject_deferred(env, asyncContext->deferred, result);
+                }
+            } else {
+                SetCallback(env, asyncContext->callbackRef, errorCode, result);
+                napi_delete_reference(env, asyncContext->callbackRef);
+            }
+            napi_delete_async_work(env, asyncContext->work);
+            delete asyncContext;
+            asyncContext = nullptr;
+        },
+        (void *)asyncContext, &asyncContext->work);
+    napi_queue_async_work(env, asyncContext->work);
+    if (asyncWork != napi_ok) {
+        delete asyncContext;
+        asyncContext = nullptr;
+    }
+
+    return promise;
+}
+
 napi_value SystemPasteboardNapi::SystemPasteboardInit(napi_env env, napi_value exports)
 {
     napi_status status = napi_ok;
@@ -788,6 +1061,9 @@ napi_value SystemPasteboardNapi::SystemPasteboardInit(napi_env env, napi_value e
         DECLARE_NAPI_FUNCTION("clear", Clear),
         DECLARE_NAPI_FUNCTION("getPasteData", GetPasteData),
         DECLARE_NAPI_FUNCTION("hasPasteData", HasPasteData),
+        DECLARE_NAPI_FUNCTION("getChangeCount", GetChangeCount),
+        DECLARE_NAPI_FUNCTION("openRecordReader", OpenRecordReader),
+        DECLARE_NAPI_FUNCTION("beginPasteWriter", BeginPasteWriter),
         DECLARE_NAPI_FUNCTION("setPasteData", SetPasteData),
     };
     napi_value constructor;
@@ -69,7 +69,7 @@ napi_value PasteDataNapi::AddHtmlRecord(napi_env env, napi_callback_info info)
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get AddHtmlRecord object failed");
         return nullptr;
     }
-    obj->value_->AddHtmlRecord(text);
+    obj->value_->AddHtmlRecord(std::move(text));
     return nullptr;
 }
 
@@ -102,7 +102,7 @@ napi_value PasteDataNapi::AddTextRecord(napi_env env, napi_callback_info info)
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get AddTextRecord object failed");
         return nullptr;
     }
-    obj->value_->AddTextRecord(text);
+    obj->value_->AddTextRecord(std::move(text));
     return nullptr;
 }
 
@@ -49,7 +49,7 @@ bool PasteDataRecordNapi::NewInstanceByRecord(
     return true;
 }
 
-bool PasteDataRecordNapi::NewHtmlTextRecordInstance(napi_env env, const std::string &text, napi_value &instance)
+bool PasteDataRecordNapi::NewHtmlTextRecordInstance(napi_env env, std::string &&text, napi_value &instance)
 {
     NAPI_CALL_BASE(env, PasteDataRecordNapi::NewInstance(env, instance), false);
     PasteDataRecordNapi *obj = nullptr;
@@ -57,12 +57,12 @@ bool PasteDataRecordNapi::NewHtmlTextRecordInstance(napi_env env, const std::str
     if ((status != napi_ok) || (obj == nullptr)) {
         return false;
     }
-    obj->value_ = PasteboardClient::GetInstance()->CreateHtmlTextRecord(text);
+    obj->value_ = PasteboardClient::GetInstance()->CreateHtmlTextRecord(std::move(text));
     obj->JSFillInstance(env, instance);
     return true;
 }
 
-bool PasteDataRecordNapi::NewPlainTextRecordInstance(napi_env env, const std::string &text, napi_value &instance)
+bool PasteDataRecordNapi::NewPlainTextRecordInstance(napi_env env, std::string &&text, napi_value &instance)
 {
     NAPI_CALL_BASE(env, PasteDataRecordNapi::NewInstance(env, instance), false);
     PasteDataRecordNapi *obj = nullptr;
@@ -70,7 +70,7 @@ bool PasteDataRecordNapi::NewPlainTextRecordInstance(napi_env env, const std::st
     if ((status != napi_ok) || (obj == nullptr)) {
         return false;
     }
-    obj->value_ = PasteboardClient::GetInstance()->CreatePlainTextRecord(text);
+    obj->value_ = PasteboardClient::GetInstance()->CreatePlainTextRecord(std::move(text));
     obj->JSFillInstance(env, instance);
     return true;
 }
@@ -115,43 +115,61 @@ void PasteDataRecordNapi::SetNamedPropertyByStr(napi_env env, napi_value &dstObj
     }
 }
 
+const std::array<PasteDataRecordNapi::FillFunc, MIME_ID_BUILTIN_COUNT> PasteDataRecordNapi::fillFuncs_ = [] {
+    std::array<FillFunc, MIME_ID_BUILTIN_COUNT> funcs {};
+    funcs[MIME_ID_TEXT_HTML] = &PasteDataRecordNapi::FillHtmlText;
+    funcs[MIME_ID_TEXT_PLAIN] = &PasteDataRecordNapi::FillPlainText;
+    funcs[MIME_ID_TEXT_URI] = &PasteDataRecordNapi::FillUri;
+    funcs[MIME_ID_TEXT_WANT] = &PasteDataRecordNapi::FillWant;
+    return funcs;
+}();
+
+void PasteDataRecordNapi::FillHtmlText(napi_env env, napi_value &instance)
+{
+    auto htmlText = value_->GetHtmlText();
+    if (htmlText != nullptr) {
+        SetNamedPropertyByStr(env, instance, "htmlText", htmlText->c_str());
+    }
+}
+
+void PasteDataRecordNapi::FillPlainText(napi_env env, napi_value &instance)
+{
+    auto plainText = value_->GetPlainText();
+    if (plainText != nullptr) {
+        SetNamedPropertyByStr(env, instance, "plainText", plainText->c_str());
+    }
+}
+
+void PasteDataRecordNapi::FillUri(napi_env env, napi_value &instance)
+{
+    auto uri = value_->GetUri();
+    if (uri != nullptr) {
+        SetNamedPropertyByStr(env, instance, "uri", uri->ToString().c_str());
+    }
+}
+
+void PasteDataRecordNapi::FillWant(napi_env env, napi_value &instance)
+{
+    auto want = value_->GetWant();
+    if (want != nullptr) {
+        napi_value jsWant = OHOS::AppExecFwk::WrapWant(env, *want);
+        napi_set_named_property(env, instance, "want", jsWant);
+    }
+}
+
 bool PasteDataRecordNapi::JSFillInstance(napi_env env, napi_value &instance)
 {
     if (!instance || !value_) {
         return false;
     }
-    auto mimeType = value_->GetMimeType();
+    const std::string &mimeType = value_->GetMimeType();
     SetNamedPropertyByStr(env, instance, "mimeType", mimeType.c_str());
-    if (mimeType == MIMETYPE_TEXT_PLAIN) {
-        auto plainText = value_->GetPlainText();
-        if (plainText != nullptr) {
-            SetNamedPropertyByStr(env, instance, "plainText", plainText->c_str());
-        }
-    } else if (mimeType == MIMETYPE_TEXT_HTML) {
-        auto htmlText = value_->GetHtmlText();
-        if (htmlText != nullptr) {
-            SetNamedPropertyByStr(env, instance, "htmlText", htmlText->c_str());
-        }
-    } else if (mimeType == MIMETYPE_TEXT_URI) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "ggg.");
-        auto uri = value_->GetUri();
-        if (uri != nullptr) {
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "hhh.");
-            SetNamedPropertyByStr(env, instance, "uri", uri->ToString().c_str());
-        }
-    } else if (mimeType == MIMETYPE_TEXT_WANT) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "iii.");
-        auto want = value_->GetWant();
-        if (want != nullptr) {
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "jjj.");
-            napi_value jsWant = OHOS::AppExecFwk::WrapWant(env, *want);
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "kkk.");
-            napi_set_named_property(env, instance, "want", jsWant);
-        }
-    } else {
+    MimeTypeId id = value_->GetMimeTypeId();
+    if (id >= MIME_ID_BUILTIN_COUNT || fillFuncs_[id] == nullptr) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "Unkonw MimeType: %{public}s.", mimeType.c_str());
         return false;
     }
+    (this->*fillFuncs_[id])(env, instance);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_JS_NAPI, "end.");
     return true;
 }
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "record_reader_napi.h"
+
+#include <algorithm>
+#include <new>
+#include "napi_common.h"
+#include "pasteboard_client.h"
+#include "pasteboard_common.h"
+#include "pasteboard_hilog_wreapper.h"
+
+using namespace OHOS::MiscServices;
+
+namespace OHOS {
+namespace MiscServicesNapi {
+namespace {
+thread_local napi_ref g_recordReader = nullptr;
+const size_t ARGC_TYPE_SET1 = 1;
+// Chunk size of a read that does not ask for one.
+const uint32_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+struct ReadContext {
+    napi_env env = nullptr;
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    napi_ref thisRef = nullptr;
+    RecordReaderNapi *obj = nullptr;
+    uint32_t readerId = 0;
+    uint64_t offset = 0;
+    uint32_t length = 0;
+    std::string chunk;
+    bool ok = false;
+};
+}
+
+RecordReaderNapi::RecordReaderNapi() : env_(nullptr), wrapper_(nullptr)
+{
+}
+
+RecordReaderNapi::~RecordReaderNapi()
+{
+    if (readerId_ != 0) {
+        PasteboardClient::GetInstance()->CloseRecordReader(readerId_);
+    }
+    napi_delete_reference(env_, wrapper_);
+}
+
+napi_value RecordReaderNapi::CreateIteratorResult(napi_env env, const std::string *value)
+{
+    napi_value result = nullptr;
+    napi_value done = nullptr;
+    NAPI_CALL(env, napi_create_object(env, &result));
+    NAPI_CALL(env, napi_get_boolean(env, value == nullptr, &done));
+    NAPI_CALL(env, napi_set_named_property(env, result, "done", done));
+    napi_value chunk = nullptr;
+    if (value == nullptr) {
+        NAPI_CALL(env, napi_get_undefined(env, &chunk));
+    } else {
+        NAPI_CALL(env, napi_create_string_utf8(env, value->data(), value->size(), &chunk));
+    }
+    NAPI_CALL(env, napi_set_named_property(env, result, "value", chunk));
+    return result;
+}
+
+napi_value RecordReaderNapi::Read(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGC_TYPE_SET1;
+    napi_value argv[ARGC_TYPE_SET1] = {0};
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr));
+    RecordReaderNapi *obj = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisVar, reinterpret_cast<void **>(&obj)));
+    NAPI_ASSERT(env, obj != nullptr, "Wrong object.");
+    uint32_t length = DEFAULT_CHUNK_SIZE;
+    napi_valuetype valueType = napi_undefined;
+    if (argc >= ARGC_TYPE_SET1) {
+        NAPI_CALL(env, napi_typeof(env, argv[0], &valueType));
+    }
+    if (valueType != napi_undefined) {
+        NAPI_ASSERT(env, valueType == napi_number, "Wrong argument type. Number expected.");
+        NAPI_CALL(env, napi_get_value_uint32(env, argv[0], &length));
+    }
+    NAPI_ASSERT(env, !obj->reading_, "Another read is pending.");
+
+    napi_value promise = nullptr;
+    ReadContext *context = new (std::nothrow) ReadContext {.env = env, .work = nullptr};
+    if (context == nullptr) {
+        return NapiGetNull(env);
+    }
+    napi_create_promise(env, &context->deferred, &promise);
+    if (obj->readerId_ == 0) {
+        // closed, or the end was reached
+        napi_resolve_deferred(env, context->deferred, CreateIteratorResult(env, nullptr));
+        delete context;
+        return promise;
+    }
+    napi_create_reference(env, thisVar, 1, &context->thisRef);
+    context->obj = obj;
+    context->readerId = obj->readerId_;
+    context->offset = obj->offset_;
+    context->length = std::max(length, 1u);
+
+    napi_value resource = nullptr;
+    napi_create_string_latin1(env, "ReadRecordChunk", NAPI_AUTO_LENGTH, &resource);
+    napi_status asyncWork = napi_create_async_work(env,
+        nullptr,
+        resource,
+        [](napi_env env, void *data) {
+            ReadContext *context = (ReadContext *)data;
+            context->ok = PasteboardClient::GetInstance()->ReadRecordChunk(context->readerId, context->offset,
+                context->length, context->chunk);
+        },
+        [](napi_env env, napi_status status, void *data) {
+            ReadContext *context = (ReadContext *)data;
+            RecordReaderNapi *obj = context->obj;
+            obj->reading_ = false;
+            if (context->ok) {
+                obj->offset_ = context->offset + context->chunk.size();
+                if (context->chunk.empty() && obj->readerId_ == context->readerId) {
+                    // nothing left, the service can let go of the content
+                    PasteboardClient::GetInstance()->CloseRecordReader(obj->readerId_);
+                    obj->readerId_ = 0;
+                }
+                napi_resolve_deferred(env, context->deferred,
+                    CreateIteratorResult(env, context->chunk.empty() ? nullptr : &context->chunk));
+            } else {
+                napi_reject_deferred(env, context->deferred, GetCallbackErrorValue(env, -1));
+            }
+            napi_delete_reference(env, context->thisRef);
+            napi_delete_async_work(env, context->work);
+            delete context;
+        },
+        (void *)context, &context->work);
+    if (asyncWork != napi_ok) {
+        napi_delete_reference(env, context->thisRef);
+        delete context;
+        return NapiGetNull(env);
+    }
+    obj->reading_ = true;
+    napi_queue_async_work(env, context->work);
+    return promise;
+}
+
+napi_value RecordReaderNapi::Close(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr));
+    RecordReaderNapi *obj = nullptr;
+    NAPI_CALL(env, napi_unwrap(env, thisVar, reinterpret_cast<void **>(&obj)));
+    if (obj != nullptr && obj->readerId_ != 0) {
+        PasteboardClient::GetInstance()->CloseRecordReader(obj->readerId_);
+        obj->readerId_ = 0;
+    }
+    return NapiGetNull(env);
+}
+
+napi_value RecordReaderNapi::GetAsyncIterator(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr));
+    return thisVar;
+}
+
+napi_value RecordReaderNapi::RecordReaderInit(napi_env env, napi_value exports)
+{
+    napi_property_descriptor properties[] = {
+        DECLARE_NAPI_FUNCTION("read", Read),
+        DECLARE_NAPI_FUNCTION("next", Read),
+        DECLARE_NAPI_FUNCTION("close", Close),
+    };
+
+    napi_value constructor;
+    napi_status status = napi_define_class(env,
+        "RecordReader",
+        NAPI_AUTO_LENGTH,
+        New,
+        nullptr,
+        sizeof(properties) / sizeof(napi_property_descriptor),
+        properties,
+        &constructor);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Failed to define class at RecordReaderInit");
+        return nullptr;
+    }
+
+    // for await (const chunk of reader) works through read, under the name next
+    napi_value global = nullptr;
+    napi_value symbol = nullptr;
+    napi_value asyncIterator = nullptr;
+    napi_value prototype = nullptr;
+    napi_value function = nullptr;
+    if (napi_get_global(env, &global) != napi_ok ||
+        napi_get_named_property(env, global, "Symbol", &symbol) != napi_ok ||
+        napi_get_named_property(env, symbol, "asyncIterator", &asyncIterator) != napi_ok ||
+        napi_get_named_property(env, constructor, "prototype", &prototype) != napi_ok ||
+        napi_create_function(env, "asyncIterator", NAPI_AUTO_LENGTH, GetAsyncIterator, nullptr, &function) !=
+            napi_ok ||
+        napi_set_property(env, prototype, asyncIterator, function) != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "RecordReaderInit set async iterator failed");
+    }
+
+    status = napi_create_reference(env, constructor, 1, &g_recordReader);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "RecordReaderInit create referece failed");
+        return nullptr;
+    }
+    return exports;
+}
+
+void RecordReaderNapi::Destructor(napi_env env, void *nativeObject, void *finalize_hint)
+{
+    RecordReaderNapi *obj = static_cast<RecordReaderNapi *>(nativeObject);
+    delete obj;
+}
+
+napi_value RecordReaderNapi::New(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+
+    RecordReaderNapi *obj = new (std::nothrow) RecordReaderNapi();
+    if (obj == nullptr) {
+        return nullptr;
+    }
+    obj->env_ = env;
+    NAPI_CALL(env, napi_wrap(env, thisVar, obj, RecordReaderNapi::Destructor, nullptr, &obj->wrapper_));
+    return thisVar;
+}
+
+napi_status RecordReaderNapi::NewInstance(napi_env env, napi_value &instance)
+{
+    napi_value constructor;
+    napi_status status = napi_get_reference_value(env, g_recordReader, &constructor);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "get referece failed");
+        return status;
+    }
+    status = napi_new_instance(env, constructor, 0, nullptr, &instance);
+    if (status != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "new instance failed");
+        return status;
+    }
+    return napi_ok;
+}
+} // namespace MiscServicesNapi
+} // namespace OHOS
@@ -14,6 +14,10 @@
  */
 #include "pasteboard_common.h"
 
+#include "pasteboard_hilog_wreapper.h"
+
+using namespace OHOS::MiscServices;
+
 namespace OHOS {
 namespace MiscServicesNapi {
 const size_t ARGC_TYPE_SET2 = 2;
@@ -61,5 +65,51 @@ napi_value CreateNapiString(napi_env env, std::string str)
     napi_create_string_utf8(env, str.c_str(), NAPI_AUTO_LENGTH, &value);
     return value;
 }
+
+bool GetNapiString(napi_env env, napi_value value, std::string &str)
+{
+    napi_valuetype valueType = napi_undefined;
+    if (napi_typeof(env, value, &valueType) != napi_ok || valueType != napi_string) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Wrong argument type. String expected.");
+        return false;
+    }
+    size_t len = 0;
+    if (napi_get_value_string_utf8(env, value, nullptr, 0, &len) != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get length failed");
+        return false;
+    }
+    // decode straight into the string, its terminator slot takes the trailing NUL
+    str.resize(len);
+    if (napi_get_value_string_utf8(env, value, &str[0], len + 1, &len) != napi_ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Get data failed");
+        return false;
+    }
+    str.resize(len);
+    return true;
+}
+
+bool GetNapiStringArray(napi_env env, napi_value value, std::vector<std::string> &strs)
+{
+    bool isArray = false;
+    if (napi_is_array(env, value, &isArray) != napi_ok || !isArray) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_JS_NAPI, "Wrong argument type. Array expected.");
+        return false;
+    }
+    uint32_t length = 0;
+    if (napi_get_array_length(env, value, &length) != napi_ok) {
+        return false;
+    }
+    strs.clear();
+    strs.reserve(length);
+    for (uint32_t i = 0; i < length; ++i) {
+        napi_value element = nullptr;
+        std::string str;
+        if (napi_get_element(env, value, i, &element) != napi_ok || !GetNapiString(env, element, str)) {
+            return false;
+        }
+        strs.push_back(std::move(str));
+    }
+    return true;
+}
 } // namespace MiscServicesNapi
 } // namespace OHOS
\ No newline at end of file
@@ -17,6 +17,7 @@
 #define PASTE_BOARD_CHANGER_OBSERVER_INTERFACE_H
 
 #include "iremote_broker.h"
+#include "pasteboard_changed_event.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -26,6 +27,17 @@ public:
         ON_PASTE_BOARD_CHANGE = 0,
     };
     virtual void OnPasteboardChanged() = 0;
+    // Observers that only need to know that something changed can keep overriding the overload above.
+    virtual void OnPasteboardChanged(const PasteboardChangedEvent &event)
+    {
+        OnPasteboardChanged();
+    }
+    // Delivers the event as the overload above does, false means it was not handed over to the observer.
+    virtual bool SendPasteboardChanged(const PasteboardChangedEvent &event)
+    {
+        OnPasteboardChanged(event);
+        return true;
+    }
     virtual ~IPasteboardChangedObserver() = default;
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.miscservices.pasteboard.IPasteboardChangedObserver");
 };
@@ -19,6 +19,7 @@
 #include "i_pasteboard_observer.h"
 #include "iremote_broker.h"
 #include "paste_data.h"
+#include "paste_data_summary.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -31,15 +32,49 @@ public:
         CLEAR_ALL = 3,
         ADD_OBSERVER = 4,
         DELETE_OBSERVER = 5,
-        DELETE_ALL_OBSERVER
+        DELETE_ALL_OBSERVER = 6,
+        ADD_EVENT_OBSERVER = 7,
+        DELETE_EVENT_OBSERVER = 8,
+        GET_CHANGE_COUNT = 9,
+        GET_PASTE_DATA_IF_CHANGED = 10,
+        GET_PASTE_DATA_SUMMARY = 11,
+        GET_RECORD_AT = 12,
+        GET_FIRST_RECORD = 13,
+        OPEN_RECORD_READER = 14,
+        READ_RECORD_CHUNK = 15,
+        CLOSE_RECORD_READER = 16,
+        BEGIN_PASTE_WRITER = 17,
+        ADD_WRITER_RECORD = 18,
+        APPEND_WRITER_CHUNK = 19,
+        COMMIT_PASTE_WRITER = 20,
+        ABORT_PASTE_WRITER = 21
     };
+    // Largest chunk one READ_RECORD_CHUNK returns or one APPEND_WRITER_CHUNK takes, reads are cut to it.
+    static constexpr uint32_t MAX_RECORD_CHUNK_SIZE = 256 * 1024;
     virtual void Clear() = 0;
     virtual bool GetPasteData(PasteData& data) = 0;
     virtual bool HasPasteData() = 0;
     virtual void SetPasteData(PasteData& pasteData) = 0;
-    virtual void AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer) = 0;
+    virtual void AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer,
+        const std::vector<std::string> &mimeTypes) = 0;
     virtual void RemovePasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer) = 0;
     virtual void RemoveAllChangedObserver() = 0;
+    virtual void AddPasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer) = 0;
+    virtual void RemovePasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer) = 0;
+    virtual int64_t GetChangeCount() = 0;
+    virtual bool GetPasteDataIfChanged(int64_t &changeCount, PasteData &data, bool &modified) = 0;
+    virtual bool GetPasteDataSummary(PasteDataSummary &summary) = 0;
+    virtual bool GetRecordAt(uint32_t index, PasteData &data) = 0;
+    virtual bool GetFirstRecord(const std::string &mimeType, PasteData &data) = 0;
+    virtual uint32_t OpenRecordReader(uint32_t index, const sptr<IRemoteObject> &token, std::string &mimeType,
+        uint64_t &size) = 0;
+    virtual bool ReadRecordChunk(uint32_t readerId, uint64_t offset, uint32_t length, std::string &chunk) = 0;
+    virtual void CloseRecordReader(uint32_t readerId) = 0;
+    virtual uint32_t BeginPasteWriter(const sptr<IRemoteObject> &token) = 0;
+    virtual bool AddWriterRecord(uint32_t writerId, const std::string &mimeType, uint64_t size) = 0;
+    virtual bool AppendWriterChunk(uint32_t writerId, const char *data, std::size_t size) = 0;
+    virtual bool CommitPasteWriter(uint32_t writerId) = 0;
+    virtual void AbortPasteWriter(uint32_t writerId) = 0;
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.miscservices.pasteboard.IPasteboardService");
 };
 } // namespace MiscServices
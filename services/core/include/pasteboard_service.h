@@ -22,21 +22,26 @@
 #include <atomic>
 #include <condition_variable>
 #include <ctime>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <stack>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 
 #include "bundle_mgr_proxy.h"
 #include "event_handler.h"
 #include "i_pasteboard_observer.h"
 #include "iremote_object.h"
 #include "paste_data.h"
+#include "pasteboard_changed_event.h"
 #include "pasteboard_dump_helper.h"
 #include "pasteboard_service_stub.h"
 #include "pasteboard_storage.h"
+#include "shared_text.h"
 #include "system_ability.h"
 
 namespace OHOS {
@@ -46,6 +51,24 @@ enum class ServiceRunningState {
     STATE_RUNNING
 };
 
+class PasteboardObserverDeathRecipient final : public IRemoteObject::DeathRecipient {
+public:
+    explicit PasteboardObserverDeathRecipient() = default;
+    ~PasteboardObserverDeathRecipient() = default;
+    void OnRemoteDied(const wptr<IRemoteObject> &remote) override;
+private:
+    DISALLOW_COPY_AND_MOVE(PasteboardObserverDeathRecipient);
+};
+
+class PasteboardSessionDeathRecipient final : public IRemoteObject::DeathRecipient {
+public:
+    explicit PasteboardSessionDeathRecipient() = default;
+    ~PasteboardSessionDeathRecipient() = default;
+    void OnRemoteDied(const wptr<IRemoteObject> &remote) override;
+private:
+    DISALLOW_COPY_AND_MOVE(PasteboardSessionDeathRecipient);
+};
+
 class PasteboardService final : public SystemAbility,
                                 public PasteboardServiceStub,
                                 public std::enable_shared_from_this<PasteboardService> {
@@ -57,47 +80,167 @@ public:
     virtual bool GetPasteData(PasteData& data) override;
     virtual bool HasPasteData() override;
     virtual void SetPasteData(PasteData& pasteData) override;
-    virtual void AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer) override;
+    virtual void AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer,
+        const std::vector<std::string> &mimeTypes) override;
     virtual void RemovePasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer) override;
     virtual void RemoveAllChangedObserver() override;
+    virtual void AddPasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer) override;
+    virtual void RemovePasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer) override;
+    virtual int64_t GetChangeCount() override;
+    virtual bool GetPasteDataIfChanged(int64_t &changeCount, PasteData &data, bool &modified) override;
+    virtual bool GetPasteDataSummary(PasteDataSummary &summary) override;
+    virtual bool GetRecordAt(uint32_t index, PasteData &data) override;
+    virtual bool GetFirstRecord(const std::string &mimeType, PasteData &data) override;
+    virtual uint32_t OpenRecordReader(uint32_t index, const sptr<IRemoteObject> &token, std::string &mimeType,
+        uint64_t &size) override;
+    virtual bool ReadRecordChunk(uint32_t readerId, uint64_t offset, uint32_t length, std::string &chunk) override;
+    virtual void CloseRecordReader(uint32_t readerId) override;
+    virtual uint32_t BeginPasteWriter(const sptr<IRemoteObject> &token) override;
+    virtual bool AddWriterRecord(uint32_t writerId, const std::string &mimeType, uint64_t size) override;
+    virtual bool AppendWriterChunk(uint32_t writerId, const char *data, std::size_t size) override;
+    virtual bool CommitPasteWriter(uint32_t writerId) override;
+    virtual void AbortPasteWriter(uint32_t writerId) override;
     virtual void OnStart() override;
     virtual void OnStop() override;
     size_t GetDataSize(PasteData& data) const;
     bool GetBundleNameByUid(int32_t uid, std::string &bundleName);
-    bool SetPasteboardHistory(int32_t uId, std::string state, std::string timeStamp);
     int Dump(int fd, const std::vector<std::u16string> &args) override;
-    std::string DumpHistory() const;
+    std::string DumpHistory();
+    std::string DumpNotifyStats();
     std::string  DunmpData();
+    void OnObserverDied(const wptr<IRemoteObject> &remote);
+    void OnSessionClientDied(const wptr<IRemoteObject> &remote);
 private:
-    struct classcomp {
-        bool operator() (const sptr<IPasteboardChangedObserver>& l, const sptr<IPasteboardChangedObserver>& r) const
-        {
-            return l->AsObject() < r->AsObject();
-        }
+    struct ObserverEntry {
+        sptr<IPasteboardChangedObserver> observer;
+        sptr<IRemoteObject::DeathRecipient> deathRecipient;
+        pid_t pid = 0;
+        // Empty means every change is delivered.
+        std::vector<std::string> mimeTypes;
+    };
+    // Keyed by the observer's remote object, which is resolved once when the observer is added.
+    using ObserverMap = std::unordered_map<IRemoteObject *, ObserverEntry>;
+    // A published clip together with the change event that produced it; never modified once published.
+    struct ClipSnapshot {
+        std::shared_ptr<PasteData> data;
+        PasteboardChangedEvent event;
+    };
+    struct UserShard {
+        explicit UserShard(int32_t id) : userId(id) {}
+        const int32_t userId;
+        // Latest snapshot, only accessed through std::atomic_load/std::atomic_compare_exchange_strong.
+        // Its data is null before the first copy and after a clear.
+        std::shared_ptr<const ClipSnapshot> clip;
+        std::atomic<uint64_t> notifyCount { 0 };
+        // Notifications that could not be handed over, typically to an observer too slow to drain them.
+        std::atomic<uint64_t> notifyDropCount { 0 };
+        // Guards everything below; never held together with another shard's mutex.
+        std::mutex mutex;
+        // Set while a dispatch task for this user is queued; further changes fold into that task.
+        bool notifyPending = false;
+        std::set<std::string> pendingMimeTypes;
+        ObserverMap observers;
+        std::vector<std::shared_ptr<std::string>> history;
+        std::string timeForLastCopy;
+    };
+    using UserShards = std::map<int32_t, std::shared_ptr<UserShard>>;
+    // An open streaming read of one record. It pins the content it was opened on, a newer clip does not
+    // change it, and it is only usable by the process that opened it.
+    struct RecordReader {
+        pid_t pid = 0;
+        std::shared_ptr<const void> owner;
+        std::string_view content;
     };
+    // A copy assembled record by record from chunks; nothing of it is visible before the commit publishes
+    // it as a whole, and it is only usable by the process that began it.
+    struct PasteWriter {
+        pid_t pid = 0;
+        // Guards everything below, appends of one writer are serialized.
+        std::mutex mutex;
+        std::vector<std::shared_ptr<PasteDataRecord>> records;
+        uint64_t totalSize = 0;
+        // Set once a call failed, the commit then publishes nothing.
+        bool failed = false;
+        // The record being written: large text goes straight into a region, smaller text into a string.
+        bool writing = false;
+        std::string mimeType;
+        uint64_t size = 0;
+        std::string text;
+        std::unique_ptr<SharedTextBuilder> builder;
+    };
+    template<typename Session>
+    static uint32_t AddSession(std::map<uint32_t, Session> &sessions, uint32_t &lastId, pid_t pid,
+        Session session, std::size_t maxPerProcess, std::size_t maxSessions);
+    template<typename Session>
+    static std::size_t RemoveSessions(std::map<uint32_t, Session> &sessions, pid_t pid);
+    static pid_t GetSessionPid(const RecordReader &reader);
+    static pid_t GetSessionPid(const std::shared_ptr<PasteWriter> &writer);
+    bool WatchSessionClient(pid_t pid, const sptr<IRemoteObject> &token);
+    std::shared_ptr<PasteWriter> GetWriter(uint32_t writerId);
+    static bool FinishWriterRecord(PasteWriter &writer);
     int32_t Init();
     int32_t GetUserId();
-    void NotifyObservers();
+    std::shared_ptr<UserShard> GetShard(int32_t userId, bool create);
+    std::shared_ptr<UserShard> GetCallerShard(bool create);
+    std::shared_ptr<const UserShards> GetShards() const;
+    static std::shared_ptr<PasteData> GetClipData(const UserShard &shard);
+    std::shared_ptr<const ClipSnapshot> PublishClip(UserShard &shard, std::shared_ptr<PasteData> data,
+        const std::string &bundleName);
+    static uint64_t GetTotalBytes(PasteData &data);
+    bool GetSingleRecord(PasteData &data,
+        const std::function<std::shared_ptr<PasteDataRecord>(const PasteData &)> &peek);
+    std::string GetBundleName(int32_t uid);
+    void NotifyObservers(const std::shared_ptr<UserShard> &shard, const std::vector<std::string> &mimeTypes);
+    void DispatchNotifications(UserShard &shard);
+    bool IsSystemCaller() const;
+    bool AddObserverEntry(ObserverMap &observers, const sptr<IPasteboardChangedObserver> &observer,
+        const std::vector<std::string> &mimeTypes);
+    static bool IsMimeTypeMatched(const ObserverEntry &entry, const std::set<std::string> &mimeTypes);
+    void RemoveObserverEntry(ObserverMap &observers, ObserverMap::iterator it);
+    void RemoveObserverEntries(ObserverMap &observers);
+    bool RemoveDeadObserver(ObserverMap &observers, IRemoteObject *remote);
     void InitServiceHandler();
     void InitStorage();
-    void SetPasteDataDot(PasteData& pasteData);
-    void GetPasteDataDot();
+    void SetPasteDataDot(UserShard &shard, PasteData& pasteData, const std::string &bundleName);
+    void GetPasteDataDot(UserShard &shard);
+    void SetPasteboardHistory(UserShard &shard, const std::string &bundleName, const std::string &state,
+        const std::string &timeStamp);
     std::string GetTime();
     ServiceRunningState state_;
     std::shared_ptr<AppExecFwk::EventHandler> serviceHandler_;
     std::shared_ptr<IPasteboardStorage> pasteboardStorage_ = nullptr;
-    std::mutex clipMutex_;
-    std::mutex observerMutex_;
-    std::map<int32_t, std::shared_ptr<std::set<const sptr<IPasteboardChangedObserver>, classcomp>>> observerMap_;
+    // Only taken to publish a new shard; every lookup goes through the atomically loaded map.
+    std::mutex shardsMutex_;
+    std::shared_ptr<const UserShards> shards_ = std::make_shared<const UserShards>();
+    // System observers that opted in to changes of every user.
+    std::mutex eventObserverMutex_;
+    ObserverMap eventObservers_;
+    // Registered observers per client process, taken after a shard or event observer mutex.
+    std::mutex observerCountMutex_;
+    std::unordered_map<pid_t, uint32_t> observerCounts_;
+    // Open record readers by id, ids grow so the first of a process is its oldest.
+    std::mutex readerMutex_;
+    std::map<uint32_t, RecordReader> readers_;
+    uint32_t lastReaderId_ = 0;
+    // Open paste writers by id, handed out like reader ids.
+    std::mutex writerMutex_;
+    std::map<uint32_t, std::shared_ptr<PasteWriter>> writers_;
+    uint32_t lastWriterId_ = 0;
+    // Processes that opened a reader or a writer, keyed by the token they sent, so their sessions are dropped
+    // when they die. Never held together with the reader or writer mutex.
+    struct SessionClient {
+        pid_t pid = 0;
+        sptr<IRemoteObject> token;
+        sptr<IRemoteObject::DeathRecipient> deathRecipient;
+    };
+    std::mutex sessionClientMutex_;
+    std::unordered_map<IRemoteObject *, SessionClient> sessionClients_;
     const std::string filePath_ = "";
-    std::map<int32_t, std::shared_ptr<PasteData>> clips_;
 
-    int32_t uIdForLastCopy_ = 0;
-    std::string timeForLastCopy_;
-    static std::vector<std::shared_ptr<std::string>> dataHistory_;
-    
+
     static std::shared_ptr<Command> copyHistory;
     static std::shared_ptr<Command> copyData;
+    static std::shared_ptr<Command> notifyStats;
 };
 } // MiscServices
 } // OHOS
@@ -15,6 +15,8 @@
 #include "pasteboard_service.h"
 
 #include <unistd.h>
+#include <cinttypes>
+#include <chrono>
 
 #include "calculate_time_consuming.h"
 #include "dfx_code_constant.h"
@@ -26,6 +28,7 @@
 #include "pasteboard_trace.h"
 #include "reporter.h"
 #include "system_ability_definition.h"
+#include "utf_transcoder.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -33,15 +36,26 @@ namespace {
 constexpr const int GET_WRONG_SIZE = 0;
 const std::int32_t INIT_INTERVAL = 10000L;
 const std::string PASTEBOARD_SERVICE_NAME = "PasteboardService";
+const std::string NOTIFY_TASK_NAME = "PasteboardNotifyObservers";
 const std::int32_t ERROR_USERID = -1;
+const std::int32_t MAX_SYSTEM_UID = 10000;
+const std::uint32_t MAX_OBSERVERS_PER_PROCESS = 32;
+// A process opening more readers than this loses its oldest one, past the total a new one is refused.
+const std::size_t MAX_READERS_PER_PROCESS = 4;
+const std::size_t MAX_READERS = 64;
+// Writers hold their text until the commit, so fewer of them stay open and each one is bounded.
+const std::size_t MAX_WRITERS_PER_PROCESS = 2;
+const std::size_t MAX_WRITERS = 16;
+const std::size_t MAX_WRITER_RECORDS = 128;
+const uint64_t MAX_WRITER_SIZE = 16 * 1024 * 1024;
 const bool G_REGISTER_RESULT =
     SystemAbility::MakeAndRegisterAbility(DelayedSingleton<PasteboardService>::GetInstance().get());
     const std::string FAIL_TO_GET_TIME_STAMP = "FAIL_TO_GET_TIME_STAMP";
 }
 
-std::vector<std::shared_ptr<std::string>> PasteboardService::dataHistory_;
 std::shared_ptr<Command> PasteboardService::copyHistory;
 std::shared_ptr<Command> PasteboardService::copyData;
+std::shared_ptr<Command> PasteboardService::notifyStats;
 
 PasteboardService::PasteboardService()
     : SystemAbility(PASTEBOARD_SERVICE_ID, true),
@@ -93,8 +107,16 @@ void PasteboardService::OnStart()
             return true;
         });
 
+    notifyStats = std::make_shared<Command>(std::vector<std::string>{ "--notify-stats" },
+        "Show change notifications sent per user.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpNotifyStats();
+            return true;
+        });
+
     PasteboardDumpHelper::GetInstance().RegisterCommand(copyHistory);
     PasteboardDumpHelper::GetInstance().RegisterCommand(copyData);
+    PasteboardDumpHelper::GetInstance().RegisterCommand(notifyStats);
 
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "Start PasteboardService success.");
     HiViewAdapter::StartTimerThread();
@@ -107,7 +129,7 @@ void PasteboardService::OnStop()
     if (state_ != ServiceRunningState::STATE_RUNNING) {
         return;
     }
-    serviceHandler_ = nullptr;
+    std::atomic_store(&serviceHandler_, std::shared_ptr<AppExecFwk::EventHandler>());
     state_ = ServiceRunningState::STATE_NOT_START;
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "OnStop End.");
 }
@@ -120,7 +142,7 @@ void PasteboardService::InitServiceHandler()
         return;
     }
     std::shared_ptr<AppExecFwk::EventRunner> runner = AppExecFwk::EventRunner::Create(PASTEBOARD_SERVICE_NAME);
-    serviceHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    std::atomic_store(&serviceHandler_, std::make_shared<AppExecFwk::EventHandler>(runner));
     
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "InitServiceHandler Succeeded.");
 }
@@ -140,72 +162,586 @@ void PasteboardService::InitStorage()
 void PasteboardService::Clear()
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
-    auto userId = GetUserId();
-    if (userId == ERROR_USERID) {
+    auto shard = GetCallerShard(false);
+    if (shard == nullptr) {
         return;
     }
-    std::lock_guard<std::mutex> lock(clipMutex_);
-    auto it = clips_.find(userId);
-    if (it != clips_.end()) {
-        clips_.erase(it);
-        NotifyObservers();
+    auto oldClip = GetClipData(*shard);
+    if (oldClip == nullptr) {
+        return;
     }
+    PublishClip(*shard, nullptr, GetBundleName(IPCSkeleton::GetCallingUid()));
+    NotifyObservers(shard, oldClip->GetMimeTypes());
 }
 
 bool PasteboardService::GetPasteData(PasteData& data)
 {
     PasteboardTrace tracer("PasteboardService, GetPasteData");
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
-    auto userId = GetUserId();
-
-    GetPasteDataDot();
-
-    if (userId == ERROR_USERID) {
+    auto shard = GetCallerShard(true);
+    if (shard == nullptr) {
         return false;
     }
-    std::lock_guard<std::mutex> lock(clipMutex_);
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "Clips length %{public}d.", static_cast<uint32_t>(clips_.size()));
-    auto it = clips_.find(userId);
-    if (it != clips_.end()) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "find end.");
-        data = *(it->second);
-        return true;
-    } else {
+
+    GetPasteDataDot(*shard);
+
+    auto clip = GetClipData(*shard);
+    if (clip == nullptr) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "not found end.");
         return false;
     }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "find end.");
+    data = *clip;
+    return true;
 }
 
 bool PasteboardService::HasPasteData()
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
-    auto userId = GetUserId();
-    if (userId == ERROR_USERID) {
+    auto shard = GetCallerShard(false);
+    if (shard == nullptr) {
         return false;
     }
-    std::lock_guard<std::mutex> lock(clipMutex_);
-    return clips_.find(userId) != clips_.end();
+    return GetClipData(*shard) != nullptr;
 }
 
 void PasteboardService::SetPasteData(PasteData& pasteData)
 {
     PasteboardTrace tracer("PasteboardService, SetPasteData");
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
-    auto userId = GetUserId();
+    auto shard = GetCallerShard(true);
+    if (shard == nullptr) {
+        return;
+    }
 
-    SetPasteDataDot(pasteData);
+    auto bundleName = GetBundleName(IPCSkeleton::GetCallingUid());
+    SetPasteDataDot(*shard, pasteData, bundleName);
 
-    if (userId == ERROR_USERID) {
+    // the stub hands over its freshly decoded data, take it instead of copying
+    auto clip = PublishClip(*shard, std::make_shared<PasteData>(std::move(pasteData)), bundleName);
+    NotifyObservers(shard, clip->event.mimeTypes);
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "end.");
+}
+
+int64_t PasteboardService::GetChangeCount()
+{
+    auto shard = GetCallerShard(false);
+    if (shard == nullptr) {
+        return 0;
+    }
+    auto clip = std::atomic_load(&shard->clip);
+    return clip == nullptr ? 0 : static_cast<int64_t>(clip->event.seq);
+}
+
+bool PasteboardService::GetPasteDataIfChanged(int64_t &changeCount, PasteData &data, bool &modified)
+{
+    PasteboardTrace tracer("PasteboardService, GetPasteDataIfChanged");
+    modified = false;
+    auto shard = GetCallerShard(true);
+    if (shard == nullptr) {
+        return false;
+    }
+    // Read data and sequence from one snapshot so the returned count always describes the returned data.
+    auto clip = std::atomic_load(&shard->clip);
+    int64_t current = clip == nullptr ? 0 : static_cast<int64_t>(clip->event.seq);
+    bool hasPasteData = clip != nullptr && clip->data != nullptr;
+    if (current == changeCount) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "not modified.");
+        return hasPasteData;
+    }
+    changeCount = current;
+    modified = true;
+    if (!hasPasteData) {
+        return false;
+    }
+    GetPasteDataDot(*shard);
+    data = *clip->data;
+    return true;
+}
+
+bool PasteboardService::GetPasteDataSummary(PasteDataSummary &summary)
+{
+    PasteboardTrace tracer("PasteboardService, GetPasteDataSummary");
+    auto shard = GetCallerShard(false);
+    if (shard == nullptr) {
+        return false;
+    }
+    auto clip = std::atomic_load(&shard->clip);
+    if (clip == nullptr || clip->data == nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "not found end.");
+        return false;
+    }
+    // Everything here is known from the walk over the encoded records, the clip is not decoded for it.
+    auto &data = *clip->data;
+    summary.property = data.GetProperty();
+    summary.property.timestamp = clip->event.timestamp;
+    summary.recordSizes.clear();
+    for (std::size_t i = 0; i < data.GetRecordCount(); i++) {
+        auto record = data.PeekRecordAt(i);
+        summary.recordSizes.push_back(record == nullptr ? 0 : record->GetContentSize());
+    }
+    return true;
+}
+
+bool PasteboardService::GetRecordAt(uint32_t index, PasteData &data)
+{
+    PasteboardTrace tracer("PasteboardService, GetRecordAt");
+    return GetSingleRecord(data, [index](const PasteData &clip) {
+        return clip.PeekRecordAt(index);
+    });
+}
+
+bool PasteboardService::GetFirstRecord(const std::string &mimeType, PasteData &data)
+{
+    PasteboardTrace tracer("PasteboardService, GetFirstRecord");
+    return GetSingleRecord(data, [&mimeType](const PasteData &clip) {
+        return clip.PeekFirstRecord(mimeType);
+    });
+}
+
+bool PasteboardService::GetSingleRecord(PasteData &data,
+    const std::function<std::shared_ptr<PasteDataRecord>(const PasteData &)> &peek)
+{
+    auto shard = GetCallerShard(true);
+    if (shard == nullptr) {
+        return false;
+    }
+    auto clip = GetClipData(*shard);
+    if (clip == nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "not found end.");
+        return false;
+    }
+    // The record is shared as it is held, still encoded, so the reply carries only its bytes.
+    auto record = peek(*clip);
+    if (record == nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "no such record end.");
+        return false;
+    }
+    GetPasteDataDot(*shard);
+    data = PasteData();
+    data.AddRecord(std::move(record));
+    return true;
+}
+
+template<typename Session>
+uint32_t PasteboardService::AddSession(std::map<uint32_t, Session> &sessions, uint32_t &lastId, pid_t pid,
+    Session session, std::size_t maxPerProcess, std::size_t maxSessions)
+{
+    std::size_t count = 0;
+    auto oldest = sessions.end();
+    for (auto it = sessions.begin(); it != sessions.end(); ++it) {
+        if (GetSessionPid(it->second) == pid && count++ == 0) {
+            oldest = it;
+        }
+    }
+    if (count >= maxPerProcess) {
+        sessions.erase(oldest);
+    } else if (sessions.size() >= maxSessions) {
+        // only the caller's own sessions make room, another process's are never taken away
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "%{public}zu sessions open, pid = %{public}d refused.",
+            sessions.size(), pid);
+        return 0;
+    }
+    // 0 means no session, skip it when the id wraps
+    do {
+        lastId++;
+    } while (lastId == 0 || sessions.count(lastId) != 0);
+    sessions.emplace(lastId, std::move(session));
+    return lastId;
+}
+
+template<typename Session>
+std::size_t PasteboardService::RemoveSessions(std::map<uint32_t, Session> &sessions, pid_t pid)
+{
+    std::size_t removed = 0;
+    for (auto it = sessions.begin(); it != sessions.end();) {
+        if (GetSessionPid(it->second) == pid) {
+            it = sessions.erase(it);
+            removed++;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+pid_t PasteboardService::GetSessionPid(const RecordReader &reader)
+{
+    return reader.pid;
+}
+
+pid_t PasteboardService::GetSessionPid(const std::shared_ptr<PasteWriter> &writer)
+{
+    return writer->pid;
+}
+
+bool PasteboardService::WatchSessionClient(pid_t pid, const sptr<IRemoteObject> &token)
+{
+    if (token == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "no token, pid = %{public}d.", pid);
+        return false;
+    }
+    if (!token->IsProxyObject()) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(sessionClientMutex_);
+    if (sessionClients_.count(token.GetRefPtr()) != 0) {
+        return true;
+    }
+    SessionClient client;
+    client.pid = pid;
+    client.token = token;
+    client.deathRecipient = sptr<IRemoteObject::DeathRecipient>(new (std::nothrow) PasteboardSessionDeathRecipient());
+    if (client.deathRecipient == nullptr || !token->AddDeathRecipient(client.deathRecipient)) {
+        // already dead, whatever it opened now would never be released
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Add death recipient to token failed.");
+        return false;
+    }
+    sessionClients_.emplace(token.GetRefPtr(), std::move(client));
+    return true;
+}
+
+void PasteboardSessionDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &remote)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "pasteboard session client died.");
+    DelayedSingleton<PasteboardService>::GetInstance()->OnSessionClientDied(remote);
+}
+
+void PasteboardService::OnSessionClientDied(const wptr<IRemoteObject> &remote)
+{
+    auto object = remote.promote();
+    if (object == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "remote object nullptr.");
         return;
     }
-    std::lock_guard<std::mutex> lock(clipMutex_);
-    auto it = clips_.find(userId);
-    if (it != clips_.end()) {
-        clips_.erase(it);
+    pid_t pid = 0;
+    {
+        std::lock_guard<std::mutex> lock(sessionClientMutex_);
+        auto it = sessionClients_.find(object.GetRefPtr());
+        if (it == sessionClients_.end()) {
+            return;
+        }
+        pid = it->second.pid;
+        object->RemoveDeathRecipient(it->second.deathRecipient);
+        sessionClients_.erase(it);
+    }
+    std::size_t removed = 0;
+    {
+        std::lock_guard<std::mutex> lock(readerMutex_);
+        removed += RemoveSessions(readers_, pid);
+    }
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        removed += RemoveSessions(writers_, pid);
     }
-    clips_.insert(std::make_pair(userId, std::make_shared<PasteData>(pasteData)));
-    NotifyObservers();
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "Clips length %{public}d.", static_cast<uint32_t>(clips_.size()));
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "pid = %{public}d died, %{public}zu sessions dropped.", pid,
+        removed);
+}
+
+uint32_t PasteboardService::OpenRecordReader(uint32_t index, const sptr<IRemoteObject> &token, std::string &mimeType,
+    uint64_t &size)
+{
+    PasteboardTrace tracer("PasteboardService, OpenRecordReader");
+    if (!WatchSessionClient(IPCSkeleton::GetCallingPid(), token)) {
+        return 0;
+    }
+    auto shard = GetCallerShard(true);
+    if (shard == nullptr) {
+        return 0;
+    }
+    auto clip = GetClipData(*shard);
+    auto record = (clip == nullptr) ? nullptr : clip->PeekRecordAt(index);
+    if (record == nullptr) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "no such record end.");
+        return 0;
+    }
+    GetPasteDataDot(*shard);
+    // Text in shared memory or held as UTF-8 is read in place, other records are decoded once for the reader.
+    RecordReader reader;
+    reader.pid = IPCSkeleton::GetCallingPid();
+    reader.content = record->GetContent(reader.owner);
+    mimeType = record->GetMimeType();
+    size = reader.content.size();
+
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    pid_t pid = reader.pid;
+    return AddSession(readers_, lastReaderId_, pid, std::move(reader), MAX_READERS_PER_PROCESS, MAX_READERS);
+}
+
+bool PasteboardService::ReadRecordChunk(uint32_t readerId, uint64_t offset, uint32_t length, std::string &chunk)
+{
+    std::shared_ptr<const void> owner;
+    std::string_view content;
+    {
+        std::lock_guard<std::mutex> lock(readerMutex_);
+        auto it = readers_.find(readerId);
+        if (it == readers_.end() || it->second.pid != IPCSkeleton::GetCallingPid()) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "no reader %{public}u.", readerId);
+            return false;
+        }
+        // the copy below runs unlocked, the owner keeps the content alive even if the reader is closed meanwhile
+        owner = it->second.owner;
+        content = it->second.content;
+    }
+    if (offset > content.size()) {
+        return false;
+    }
+    std::size_t begin = static_cast<std::size_t>(offset);
+    std::size_t end = begin + std::min(static_cast<std::size_t>(length), content.size() - begin);
+    // End on a character boundary so every chunk is valid UTF-8. A length too short for the character at begin
+    // gets that whole character, the chunk never splits one.
+    auto isContinuation = [&content](std::size_t i) {
+        return i < content.size() && (static_cast<unsigned char>(content[i]) & 0xC0) == 0x80;
+    };
+    std::size_t boundary = end;
+    while (boundary > begin && isContinuation(boundary)) {
+        boundary--;
+    }
+    if (boundary == begin && end > begin) {
+        boundary = end;
+        while (isContinuation(boundary)) {
+            boundary++;
+        }
+    }
+    chunk.assign(content.data() + begin, boundary - begin);
+    return true;
+}
+
+void PasteboardService::CloseRecordReader(uint32_t readerId)
+{
+    std::lock_guard<std::mutex> lock(readerMutex_);
+    auto it = readers_.find(readerId);
+    if (it != readers_.end() && it->second.pid == IPCSkeleton::GetCallingPid()) {
+        readers_.erase(it);
+    }
+}
+
+uint32_t PasteboardService::BeginPasteWriter(const sptr<IRemoteObject> &token)
+{
+    auto writer = std::make_shared<PasteWriter>();
+    writer->pid = IPCSkeleton::GetCallingPid();
+    if (!WatchSessionClient(writer->pid, token)) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    pid_t pid = writer->pid;
+    return AddSession(writers_, lastWriterId_, pid, std::move(writer), MAX_WRITERS_PER_PROCESS, MAX_WRITERS);
+}
+
+bool PasteboardService::AddWriterRecord(uint32_t writerId, const std::string &mimeType, uint64_t size)
+{
+    auto writer = GetWriter(writerId);
+    if (writer == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(writer->mutex);
+    if (writer->failed || !FinishWriterRecord(*writer)) {
+        writer->failed = true;
+        return false;
+    }
+    if ((mimeType != MIMETYPE_TEXT_PLAIN && mimeType != MIMETYPE_TEXT_HTML) ||
+        size >= PasteDataRecord::MAX_TEXT_SIZE || writer->records.size() >= MAX_WRITER_RECORDS ||
+        writer->totalSize + size > MAX_WRITER_SIZE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "record %{public}s of %{public}" PRIu64 " bytes refused.",
+            mimeType.c_str(), size);
+        writer->failed = true;
+        return false;
+    }
+    writer->mimeType = mimeType;
+    writer->size = size;
+    writer->text.clear();
+    if (size >= SharedText::MIN_SIZE) {
+        writer->builder = SharedTextBuilder::Create(static_cast<std::size_t>(size));
+        if (writer->builder == nullptr) {
+            writer->failed = true;
+            return false;
+        }
+    } else {
+        writer->text.reserve(static_cast<std::size_t>(size));
+    }
+    writer->writing = true;
+    writer->totalSize += size;
+    return true;
+}
+
+bool PasteboardService::AppendWriterChunk(uint32_t writerId, const char *data, std::size_t size)
+{
+    auto writer = GetWriter(writerId);
+    if (writer == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(writer->mutex);
+    if (writer->failed || !writer->writing) {
+        return false;
+    }
+    uint64_t written = (writer->builder != nullptr) ? writer->builder->GetSize() : writer->text.size();
+    bool ok = size <= writer->size - written;
+    if (ok && writer->builder != nullptr) {
+        ok = writer->builder->Append(data, size);
+    } else if (ok) {
+        writer->text.append(data, size);
+    }
+    if (!ok) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "chunk of %{public}zu bytes refused.", size);
+        writer->failed = true;
+    }
+    return ok;
+}
+
+bool PasteboardService::CommitPasteWriter(uint32_t writerId)
+{
+    PasteboardTrace tracer("PasteboardService, CommitPasteWriter");
+    std::shared_ptr<PasteWriter> writer;
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        auto it = writers_.find(writerId);
+        if (it == writers_.end() || it->second->pid != IPCSkeleton::GetCallingPid()) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "no writer %{public}u.", writerId);
+            return false;
+        }
+        writer = std::move(it->second);
+        writers_.erase(it);
+    }
+    std::vector<std::shared_ptr<PasteDataRecord>> records;
+    {
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        if (writer->failed || !FinishWriterRecord(*writer) || writer->records.empty()) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "writer %{public}u incomplete.", writerId);
+            return false;
+        }
+        records = std::move(writer->records);
+    }
+    // The first record written is the primary one.
+    PasteData pasteData(std::move(records));
+    SetPasteData(pasteData);
+    return true;
+}
+
+void PasteboardService::AbortPasteWriter(uint32_t writerId)
+{
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    auto it = writers_.find(writerId);
+    if (it != writers_.end() && it->second->pid == IPCSkeleton::GetCallingPid()) {
+        writers_.erase(it);
+    }
+}
+
+std::shared_ptr<PasteboardService::PasteWriter> PasteboardService::GetWriter(uint32_t writerId)
+{
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    auto it = writers_.find(writerId);
+    if (it == writers_.end() || it->second->pid != IPCSkeleton::GetCallingPid()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "no writer %{public}u.", writerId);
+        return nullptr;
+    }
+    return it->second;
+}
+
+bool PasteboardService::FinishWriterRecord(PasteWriter &writer)
+{
+    if (!writer.writing) {
+        return true;
+    }
+    writer.writing = false;
+    std::shared_ptr<PasteDataRecord> record;
+    // chunks may split characters, so the text is only checked once it is whole, as a decoded record would be
+    if (writer.builder != nullptr) {
+        auto text = (writer.builder->GetSize() == writer.size) ? writer.builder->Seal() : nullptr;
+        if (text != nullptr && UtfTranscoder::IsUtf8(text->GetData(), text->GetSize())) {
+            record = PasteDataRecord::NewSharedTextRecord(writer.mimeType, std::move(text));
+        }
+        writer.builder.reset();
+    } else if (writer.text.size() == writer.size && UtfTranscoder::IsUtf8(writer.text.data(), writer.text.size())) {
+        record = (writer.mimeType == MIMETYPE_TEXT_HTML) ? PasteDataRecord::NewHtmlRecord(std::move(writer.text))
+                                                         : PasteDataRecord::NewPlaintTextRecord(std::move(writer.text));
+    }
+    if (record == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "record %{public}zu short of its size or not UTF-8.",
+            writer.records.size());
+        return false;
+    }
+    writer.records.push_back(std::move(record));
+    return true;
+}
+
+std::shared_ptr<PasteData> PasteboardService::GetClipData(const UserShard &shard)
+{
+    auto clip = std::atomic_load(&shard.clip);
+    return clip == nullptr ? nullptr : clip->data;
+}
+
+std::shared_ptr<const PasteboardService::ClipSnapshot> PasteboardService::PublishClip(UserShard &shard,
+    std::shared_ptr<PasteData> data, const std::string &bundleName)
+{
+    auto clip = std::make_shared<ClipSnapshot>();
+    if (data != nullptr) {
+        clip->event.mimeTypes = data->GetMimeTypes();
+        clip->event.recordCount = static_cast<uint32_t>(data->GetRecordCount());
+        clip->event.totalBytes = GetTotalBytes(*data);
+    }
+    clip->event.bundleName = bundleName;
+    clip->event.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    clip->data = std::move(data);
+    // Concurrent writers of one user race on the pointer; the loser retries with the next sequence number.
+    auto expected = std::atomic_load(&shard.clip);
+    std::shared_ptr<const ClipSnapshot> desired;
+    do {
+        clip->event.seq = (expected == nullptr ? 0 : expected->event.seq) + 1;
+        desired = clip;
+    } while (!std::atomic_compare_exchange_strong(&shard.clip, &expected, desired));
+    return desired;
+}
+
+uint64_t PasteboardService::GetTotalBytes(PasteData &data)
+{
+    // known from the walk over the encoded records, nothing is decoded for it
+    return data.GetContentSize();
+}
+
+std::shared_ptr<const PasteboardService::UserShards> PasteboardService::GetShards() const
+{
+    return std::atomic_load(&shards_);
+}
+
+std::shared_ptr<PasteboardService::UserShard> PasteboardService::GetShard(int32_t userId, bool create)
+{
+    auto shards = GetShards();
+    auto it = shards->find(userId);
+    if (it != shards->end()) {
+        return it->second;
+    }
+    if (!create) {
+        return nullptr;
+    }
+    // Shards are never removed, so publishing a grown copy of the map keeps every lookup lock-free.
+    std::lock_guard<std::mutex> lock(shardsMutex_);
+    shards = GetShards();
+    it = shards->find(userId);
+    if (it != shards->end()) {
+        return it->second;
+    }
+    auto newShards = std::make_shared<UserShards>(*shards);
+    auto shard = std::make_shared<UserShard>(userId);
+    newShards->insert(std::make_pair(userId, shard));
+    std::atomic_store(&shards_, std::shared_ptr<const UserShards>(std::move(newShards)));
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "new shard, userId = %{public}d.", userId);
+    return shard;
+}
+
+std::shared_ptr<PasteboardService::UserShard> PasteboardService::GetCallerShard(bool create)
+{
+    auto userId = GetUserId();
+    if (userId == ERROR_USERID) {
+        return nullptr;
+    }
+    return GetShard(userId, create);
+}
+
+void PasteboardObserverDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &remote)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "pasteboard observer died.");
+    DelayedSingleton<PasteboardService>::GetInstance()->OnObserverDied(remote);
 }
 
 int32_t PasteboardService::GetUserId()
@@ -218,95 +754,270 @@ int32_t PasteboardService::GetUserId()
     return userId;
 }
 
-void PasteboardService::AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer)
+void PasteboardService::AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer,
+    const std::vector<std::string> &mimeTypes)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
     if (observer == nullptr) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "nullptr.");
         return;
     }
-    std::lock_guard<std::mutex> lock(observerMutex_);
-    auto userId = GetUserId();
-    if (userId == ERROR_USERID) {
+    auto shard = GetCallerShard(true);
+    if (shard == nullptr) {
         return;
     }
-    auto it = observerMap_.find(userId);
-    std::shared_ptr<std::set<const sptr<IPasteboardChangedObserver>, classcomp>> observers;
-    if (it != observerMap_.end()) {
-        observers = it->second;
-    } else {
-        observers = std::make_shared<std::set<const sptr<IPasteboardChangedObserver>, classcomp>>();
-        observerMap_.insert(std::make_pair(userId, observers));
-    }
-    observers->insert(observer);
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    AddObserverEntry(shard->observers, observer, mimeTypes);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE,
         " observer = %{public}p, observers->size = %{public}d,",
         observer.GetRefPtr(),
-        static_cast<unsigned int>(observerMap_.size()));
+        static_cast<unsigned int>(shard->observers.size()));
 }
 void PasteboardService::RemovePasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
-    if (observer == nullptr) {
-        return;
-    }
-    auto userId = GetUserId();
-    if (userId == ERROR_USERID) {
+    if (observer == nullptr || observer->AsObject() == nullptr) {
         return;
     }
-    std::lock_guard<std::mutex> lock(observerMutex_);
-    auto it = observerMap_.find(userId);
-    if (it == observerMap_.end()) {
+    auto shard = GetCallerShard(false);
+    if (shard == nullptr) {
         return;
     }
-    auto observers = it->second;
+    std::lock_guard<std::mutex> lock(shard->mutex);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "observers->size: %{public}d.",
-        static_cast<unsigned int>(observers->size()));
-    auto eraseNum = observers->erase(observer);
+        static_cast<unsigned int>(shard->observers.size()));
+    auto it = shard->observers.find(observer->AsObject().GetRefPtr());
+    if (it != shard->observers.end()) {
+        RemoveObserverEntry(shard->observers, it);
+    }
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE,
-        " callback = %{public}p, listeners.size = %{public}d,"
-        " eraseNum = %{public}zu",
+        " callback = %{public}p, listeners.size = %{public}d",
         observer.GetRefPtr(),
-        static_cast<unsigned int>(observers->size()),
-        eraseNum);
+        static_cast<unsigned int>(shard->observers.size()));
 }
 
 void PasteboardService::RemoveAllChangedObserver()
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
-    auto userId = GetUserId();
-    if (userId == ERROR_USERID) {
+    auto shard = GetCallerShard(false);
+    if (shard == nullptr) {
         return;
     }
-    std::lock_guard<std::mutex> lock(observerMutex_);
-    auto it = observerMap_.find(userId);
-    if (it == observerMap_.end()) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    RemoveObserverEntries(shard->observers);
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "end.");
+}
+
+bool PasteboardService::AddObserverEntry(ObserverMap &observers, const sptr<IPasteboardChangedObserver> &observer,
+    const std::vector<std::string> &mimeTypes)
+{
+    auto remote = observer->AsObject();
+    if (remote == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "remote object nullptr.");
+        return false;
+    }
+    auto it = observers.find(remote.GetRefPtr());
+    if (it != observers.end()) {
+        it->second.mimeTypes = mimeTypes;
+        return true;
+    }
+    pid_t pid = IPCSkeleton::GetCallingPid();
+    {
+        std::lock_guard<std::mutex> lock(observerCountMutex_);
+        auto &count = observerCounts_[pid];
+        if (count >= MAX_OBSERVERS_PER_PROCESS) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "too many observers, pid = %{public}d.", pid);
+            return false;
+        }
+        ++count;
+    }
+    ObserverEntry entry;
+    entry.observer = observer;
+    entry.pid = pid;
+    entry.mimeTypes = mimeTypes;
+    if (remote->IsProxyObject()) {
+        entry.deathRecipient = sptr<IRemoteObject::DeathRecipient>(new PasteboardObserverDeathRecipient());
+        if (!remote->AddDeathRecipient(entry.deathRecipient)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Add death recipient to observer failed.");
+            entry.deathRecipient = nullptr;
+        }
+    }
+    observers.emplace(remote.GetRefPtr(), std::move(entry));
+    return true;
+}
+
+void PasteboardService::RemoveObserverEntry(ObserverMap &observers, ObserverMap::iterator it)
+{
+    auto &entry = it->second;
+    if (entry.deathRecipient != nullptr) {
+        it->first->RemoveDeathRecipient(entry.deathRecipient);
+    }
+    {
+        std::lock_guard<std::mutex> lock(observerCountMutex_);
+        auto count = observerCounts_.find(entry.pid);
+        if (count != observerCounts_.end() && --count->second == 0) {
+            observerCounts_.erase(count);
+        }
+    }
+    observers.erase(it);
+}
+
+void PasteboardService::RemoveObserverEntries(ObserverMap &observers)
+{
+    while (!observers.empty()) {
+        RemoveObserverEntry(observers, observers.begin());
+    }
+}
+
+bool PasteboardService::RemoveDeadObserver(ObserverMap &observers, IRemoteObject *remote)
+{
+    auto it = observers.find(remote);
+    if (it == observers.end()) {
+        return false;
+    }
+    RemoveObserverEntry(observers, it);
+    return true;
+}
+
+void PasteboardService::OnObserverDied(const wptr<IRemoteObject> &remote)
+{
+    auto object = remote.promote();
+    if (object == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "remote object nullptr.");
         return;
     }
-    observerMap_.erase(userId);
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "end.");
+    size_t removed = 0;
+    auto shards = GetShards();
+    for (auto &item : *shards) {
+        std::lock_guard<std::mutex> lock(item.second->mutex);
+        removed += RemoveDeadObserver(item.second->observers, object.GetRefPtr()) ? 1 : 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(eventObserverMutex_);
+        removed += RemoveDeadObserver(eventObservers_, object.GetRefPtr()) ? 1 : 0;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "dead observer removed, count = %{public}zu.", removed);
+}
+
+bool PasteboardService::IsSystemCaller() const
+{
+    return IPCSkeleton::GetCallingUid() < MAX_SYSTEM_UID;
+}
+
+void PasteboardService::AddPasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
+    if (observer == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "nullptr.");
+        return;
+    }
+    if (!IsSystemCaller()) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "permission denied, uid = %{public}d.",
+            IPCSkeleton::GetCallingUid());
+        return;
+    }
+    std::lock_guard<std::mutex> lock(eventObserverMutex_);
+    AddObserverEntry(eventObservers_, observer, {});
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "eventObservers_.size = %{public}zu.", eventObservers_.size());
 }
 
-void PasteboardService::NotifyObservers()
+void PasteboardService::RemovePasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start.");
-    std::lock_guard<std::mutex> lock(observerMutex_);
-    for (auto &observers : observerMap_) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "notify uid : %{public}d.", observers.first);
-        for (const auto &observer: *(observers.second)) {
-            observer->OnPasteboardChanged();
+    if (observer == nullptr || observer->AsObject() == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(eventObserverMutex_);
+    auto it = eventObservers_.find(observer->AsObject().GetRefPtr());
+    if (it != eventObservers_.end()) {
+        RemoveObserverEntry(eventObservers_, it);
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "eventObservers_.size = %{public}zu.", eventObservers_.size());
+}
+
+bool PasteboardService::IsMimeTypeMatched(const ObserverEntry &entry, const std::set<std::string> &mimeTypes)
+{
+    if (entry.mimeTypes.empty()) {
+        return true;
+    }
+    for (const auto &mimeType : entry.mimeTypes) {
+        if (mimeTypes.find(mimeType) != mimeTypes.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PasteboardService::NotifyObservers(const std::shared_ptr<UserShard> &shard,
+    const std::vector<std::string> &mimeTypes)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "start, userId = %{public}d.", shard->userId);
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->pendingMimeTypes.insert(mimeTypes.begin(), mimeTypes.end());
+        if (shard->notifyPending) {
+            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "coalesced into pending dispatch.");
+            return;
+        }
+        shard->notifyPending = true;
+    }
+    auto handler = std::atomic_load(&serviceHandler_);
+    auto task = [this, shard]() {
+        DispatchNotifications(*shard);
+    };
+    if (handler == nullptr || !handler->PostTask(task, NOTIFY_TASK_NAME)) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "no notify handler, dispatch inline.");
+        DispatchNotifications(*shard);
+    }
+}
+
+void PasteboardService::DispatchNotifications(UserShard &shard)
+{
+    std::set<std::string> mimeTypes;
+    std::unordered_map<IRemoteObject *, std::pair<sptr<IPasteboardChangedObserver>, pid_t>> observers;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        // cleared before anything can return, or every later change would fold into a dispatch that never runs
+        shard.notifyPending = false;
+        mimeTypes.swap(shard.pendingMimeTypes);
+        for (const auto &item : shard.observers) {
+            if (IsMimeTypeMatched(item.second, mimeTypes)) {
+                observers.emplace(item.first, std::make_pair(item.second.observer, item.second.pid));
+            }
+        }
+    }
+    // loaded after the flag is cleared, a clip published since then has queued a dispatch of its own
+    auto clip = std::atomic_load(&shard.clip);
+    if (clip == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(eventObserverMutex_);
+        for (const auto &item : eventObservers_) {
+            observers.emplace(item.first, std::make_pair(item.second.observer, item.second.pid));
         }
     }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "notify userId : %{public}d, observers : %{public}zu.",
+        shard.userId, observers.size());
+    // Sends are one-way; an observer whose async buffer is full just misses this round and
+    // picks up the latest state with the next change, so it cannot hold up the others.
+    uint64_t dropped = 0;
+    for (const auto &item : observers) {
+        if (!item.second.first->SendPasteboardChanged(clip->event)) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "notify pid %{public}d dropped, seq = %{public}" PRIu64 ".",
+                item.second.second, clip->event.seq);
+            dropped++;
+        }
+    }
+    shard.notifyCount.fetch_add(observers.size() - dropped);
+    shard.notifyDropCount.fetch_add(dropped);
 }
 
 size_t PasteboardService::GetDataSize(PasteData& data) const
 {
+    // Stored clips are shared by every reader and stay encoded, GetRecordAt would decode into them.
     if (data.GetRecordCount() != 0) {
-        size_t counts = data.GetRecordCount() - 1;
-        std::shared_ptr<PasteDataRecord> records = data.GetRecordAt(counts);
-        std::string text = records->ConvertToText();
-        size_t textSize = text.size();
-        return textSize;
+        return static_cast<size_t>(data.GetContentSize());
     }
     return GET_WRONG_SIZE;
 }
@@ -326,30 +1037,36 @@ bool PasteboardService::GetBundleNameByUid(int32_t uid, std::string &bundleName)
     return iBundleMgr->GetBundleNameForUid(uid, bundleName);
 }
 
-bool PasteboardService::SetPasteboardHistory(int32_t uid, std::string state, std::string timeStamp)
+std::string PasteboardService::GetBundleName(int32_t uid)
 {
-    constexpr const size_t DATA_HISTORY_SIZE = 10;
     std::string bundleName;
     if (GetBundleNameByUid(uid, bundleName)) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "get bundleName success!");
     } else {
         bundleName = "com.pasteboard.default";
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "default bundleName!");
     }
+    return bundleName;
+}
+
+void PasteboardService::SetPasteboardHistory(UserShard &shard, const std::string &bundleName,
+    const std::string &state, const std::string &timeStamp)
+{
+    constexpr const size_t DATA_HISTORY_SIZE = 10;
 
     std::string bundleNameState = timeStamp + "  " + bundleName + "    " + state;
     std::shared_ptr<std::string> pBundleNameState = std::make_shared<std::string>(bundleNameState);
-    if (dataHistory_.size() == DATA_HISTORY_SIZE) {
-        dataHistory_.erase(dataHistory_.begin());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.history.size() == DATA_HISTORY_SIZE) {
+        shard.history.erase(shard.history.begin());
     }
-    dataHistory_.push_back(pBundleNameState);
-    return true;
+    shard.history.push_back(pBundleNameState);
 }
 
 int PasteboardService::Dump(int fd, const std::vector<std::u16string> &args)
 {
     int uid = static_cast<int>(IPCSkeleton::GetCallingUid());
-    const int maxUid = 10000;
-    if (uid > maxUid) {
+    if (uid > MAX_SYSTEM_UID) {
         return 0;
     }
 
@@ -387,71 +1104,94 @@ std::string PasteboardService::GetTime()
     return targetTime;
 }
 
-std::string PasteboardService::DumpHistory() const
+std::string PasteboardService::DumpHistory()
 {
     std::string result;
-    if (!dataHistory_.empty()) {
-    result.append("Access history last ten times: ").append("\n");
-    for (auto iter = dataHistory_.rbegin(); iter != dataHistory_.rend(); ++iter) {
-        result.append("          ")
-            .append(**iter)
-            .append("\n");
+    auto shards = GetShards();
+    for (auto &item : *shards) {
+        std::vector<std::shared_ptr<std::string>> history;
+        {
+            std::lock_guard<std::mutex> lock(item.second->mutex);
+            history = item.second->history;
         }
-    } else {
+        if (history.empty()) {
+            continue;
+        }
+        result.append("Access history last ten times of user ").append(std::to_string(item.first))
+            .append(": ").append("\n");
+        for (auto iter = history.rbegin(); iter != history.rend(); ++iter) {
+            result.append("          ")
+                .append(**iter)
+                .append("\n");
+        }
+    }
+    if (result.empty()) {
         result.append("Access history fail! dataHistory_ no data.").append("\n");
     }
     return result;
 }
 
+std::string PasteboardService::DumpNotifyStats()
+{
+    std::string result;
+    auto shards = GetShards();
+    for (auto &item : *shards) {
+        result.append("|User ").append(std::to_string(item.first))
+            .append(" notifications sent:  ")
+            .append(std::to_string(item.second->notifyCount.load()))
+            .append(", dropped: ").append(std::to_string(item.second->notifyDropCount.load())).append("\n");
+    }
+    if (result.empty()) {
+        result.append("No notification sent.").append("\n");
+    }
+    return result;
+}
+
 std::string PasteboardService::DunmpData()
 {
     std::string result;
-    std::vector<std::string> mimeTypes;
-    std::string bundleName;
-    if (!clips_.empty()) {
-        size_t recordCounts = clips_.rbegin()->second->GetRecordCount();
-        mimeTypes = clips_.rbegin()->second->GetMimeTypes();
-        if (GetBundleNameByUid(uIdForLastCopy_, bundleName)) {
-            PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "get bundleName success!");
-        } else {
-            bundleName = "com.pasteboard.default";
+    auto shards = GetShards();
+    for (auto &item : *shards) {
+        auto clip = std::atomic_load(&item.second->clip);
+        if (clip == nullptr || clip->data == nullptr) {
+            continue;
+        }
+        std::string timeForLastCopy;
+        {
+            std::lock_guard<std::mutex> lock(item.second->mutex);
+            timeForLastCopy = item.second->timeForLastCopy;
         }
-        
-        result.append("|Owner       :  ")
-         .append(bundleName).append("\n")
+        const auto &mimeTypes = clip->event.mimeTypes;
+        result.append("|User        :  ")
+         .append(std::to_string(item.first)).append("\n")
+         .append("|Owner       :  ")
+         .append(clip->event.bundleName).append("\n")
          .append("|Timestamp   :  ")
-         .append(timeForLastCopy_).append("\n")
+         .append(timeForLastCopy).append("\n")
          .append("|Share Option: ")
          .append(" CrossDevice").append("\n")
          .append("|Record Count:  ")
-         .append(std::to_string(recordCounts)).append("\n")
+         .append(std::to_string(clip->event.recordCount)).append("\n")
          .append("|Mime types  :  {");
-        if (!mimeTypes.empty()) {
-            for (size_t i = 0; i < mimeTypes.size(); ++i) {
-                result.append(mimeTypes[i]).append(",");
-            }
+        for (size_t i = 0; i < mimeTypes.size(); ++i) {
+            result.append(mimeTypes[i]).append(",");
         }
-        result.append("}");
-    } else {
+        result.append("}").append("\n");
+    }
+    if (result.empty()) {
         result.append("No copy data.").append("\n");
     }
     return result;
 }
 
-void PasteboardService::SetPasteDataDot(PasteData& pasteData)
+void PasteboardService::SetPasteDataDot(UserShard &shard, PasteData& pasteData, const std::string &bundleName)
 {
-    int32_t uId = IPCSkeleton::GetCallingUid();
-    uIdForLastCopy_ = uId;
     std::string time = GetTime();
-    timeForLastCopy_ = time;
-    SetPasteboardHistory(uId, "Set", time);
-    std::string bundleName;
-    if (GetBundleNameByUid(uId, bundleName)) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "get bundleName success!");
-    } else {
-        bundleName = "com.pasteboard.default";
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "default bundleName!");
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.timeForLastCopy = time;
     }
+    SetPasteboardHistory(shard, bundleName, "Set", time);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "SetPasteData Report!");
     Reporter::GetInstance().PasteboardBehaviour().Report(
         { static_cast<int>(BehaviourPasteboardState::BPS_COPY_STATE), bundleName });
@@ -463,29 +1203,23 @@ void PasteboardService::SetPasteDataDot(PasteData& pasteData)
     CalculateTimeConsuming timeC(dataSize, state);
 }
 
-void PasteboardService::GetPasteDataDot()
+void PasteboardService::GetPasteDataDot(UserShard &shard)
 {
-    int32_t uId = IPCSkeleton::GetCallingUid();
-    std::string bundleName;
+    std::string bundleName = GetBundleName(IPCSkeleton::GetCallingUid());
     std::string time = GetTime();
-    SetPasteboardHistory(uId, "Get", time);
-    if (GetBundleNameByUid(uId, bundleName)) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "get bundleName success!");
-    } else {
-        bundleName = "com.pasteboard.default";
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "defaulit bundlename");
-    }
+    SetPasteboardHistory(shard, bundleName, "Get", time);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "GetPasteData Report!");
     Reporter::GetInstance().PasteboardBehaviour().Report(
         { static_cast<int>(BehaviourPasteboardState::BPS_PASTE_STATE), bundleName });
 
-    if (!clips_.empty()) {
+    auto clip = GetClipData(shard);
+    if (clip != nullptr) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "GetPasteData GetDataSize");
         int state = static_cast<int>(StatisticPasteboardState::SPS_PASTE_STATE);
-        size_t dataSize = GetDataSize(*(clips_.rbegin()->second));
+        size_t dataSize = GetDataSize(*clip);
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "GetPasteData timeC");
         CalculateTimeConsuming timeC(dataSize, state);
     }
 }
 } // MiscServices
-} // OHOS
\ No newline at end of file
+} // OHOS
@@ -0,0 +1,788 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include "ashmem.h"
+#include "ipc_file_descriptor.h"
+#include "paste_data.h"
+#include "paste_data_record.h"
+#include "paste_data_summary.h"
+#include "pasteboard_client.h"
+#include "record_task_pool.h"
+#include "shared_text.h"
+#include "utf_transcoder.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::MiscServices;
+
+namespace {
+// Far larger than any bookkeeping allocation, so allocations of at least this size are payload copies.
+constexpr std::size_t PAYLOAD_SIZE = 64 * 1024;
+std::atomic<uint32_t> g_payloadAllocs { 0 };
+std::atomic<uint32_t> g_allocs { 0 };
+} // namespace
+
+// The replacements stay out of line, so the compiler pairs new with delete rather than malloc with free.
+__attribute__((noinline)) void *operator new(std::size_t size)
+{
+    g_allocs++;
+    if (size >= PAYLOAD_SIZE) {
+        g_payloadAllocs++;
+    }
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+__attribute__((noinline)) void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void *ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+    std::free(ptr);
+}
+
+class PasteDataTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteDataTest::SetUpTestCase(void)
+{}
+
+void PasteDataTest::TearDownTestCase(void)
+{}
+
+void PasteDataTest::SetUp(void)
+{}
+
+void PasteDataTest::TearDown(void)
+{}
+
+namespace {
+/**
+* @tc.name: PasteDataMoveTest001
+* @tc.desc: A text moved into the client is stored without copying the payload.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataMoveTest001, TestSize.Level0)
+{
+    std::string text(PAYLOAD_SIZE, 'a');
+    const char *payload = text.data();
+    g_payloadAllocs = 0;
+    auto data = PasteboardClient::GetInstance()->CreatePlainTextData(std::move(text));
+    EXPECT_EQ(g_payloadAllocs.load(), 0u);
+    ASSERT_TRUE(data != nullptr && data->GetPrimaryText() != nullptr);
+    EXPECT_EQ(data->GetPrimaryText()->data(), payload);
+
+    std::string html(PAYLOAD_SIZE, 'b');
+    payload = html.data();
+    g_payloadAllocs = 0;
+    auto record = PasteboardClient::GetInstance()->CreateHtmlTextRecord(std::move(html));
+    EXPECT_EQ(g_payloadAllocs.load(), 0u);
+    ASSERT_TRUE(record != nullptr && record->GetHtmlText() != nullptr);
+    EXPECT_EQ(record->GetHtmlText()->data(), payload);
+}
+
+/**
+* @tc.name: PasteDataMoveTest002
+* @tc.desc: Adding moved texts and records to paste data does not copy the payload.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataMoveTest002, TestSize.Level0)
+{
+    PasteData data;
+    std::string html(PAYLOAD_SIZE, 'a');
+    std::string text(PAYLOAD_SIZE, 'b');
+    auto record = PasteDataRecord::NewPlaintTextRecord(std::string(PAYLOAD_SIZE, 'c'));
+    ASSERT_TRUE(record != nullptr);
+    g_payloadAllocs = 0;
+    data.AddHtmlRecord(std::move(html));
+    data.AddTextRecord(std::move(text));
+    data.AddRecord(std::move(*record));
+    EXPECT_EQ(g_payloadAllocs.load(), 0u);
+    EXPECT_TRUE(data.GetRecordCount() == 3);
+}
+
+/**
+* @tc.name: PasteDataMoveTest003
+* @tc.desc: Decoded paste data is handed on without copying the payload, and the source is left empty.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataMoveTest003, TestSize.Level0)
+{
+    PasteData data;
+    data.AddTextRecord(std::string(PAYLOAD_SIZE, 'a'));
+    Parcel parcel;
+    ASSERT_TRUE(data.Marshalling(parcel));
+    std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel));
+    ASSERT_TRUE(decoded != nullptr && decoded->GetPrimaryText() != nullptr);
+    const char *payload = decoded->GetPrimaryText()->data();
+
+    g_payloadAllocs = 0;
+    auto clip = std::make_shared<PasteData>(std::move(*decoded));
+    EXPECT_EQ(g_payloadAllocs.load(), 0u);
+    ASSERT_TRUE(clip->GetPrimaryText() != nullptr);
+    EXPECT_EQ(clip->GetPrimaryText()->data(), payload);
+    EXPECT_TRUE(decoded->GetRecordCount() == 0);
+    EXPECT_TRUE(decoded->GetPrimaryText() == nullptr);
+}
+
+/**
+* @tc.name: PasteDataSizeTest001
+* @tc.desc: SerializedSize matches the bytes written, and a clip over the parcel limit is rejected before writing.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataSizeTest001, TestSize.Level0)
+{
+    PasteData data;
+    data.AddTextRecord("plain text");
+    data.AddHtmlRecord("<p>\xe4\xbd\xa0\xe5\xa5\xbd \xf0\x9f\x98\x80</p>");
+    data.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    Parcel parcel;
+    ASSERT_TRUE(data.Marshalling(parcel));
+    EXPECT_EQ(parcel.GetDataSize(), data.SerializedSize());
+
+    Parcel small;
+    ASSERT_TRUE(small.SetMaxCapacity(data.SerializedSize() - 1));
+    EXPECT_FALSE(data.Marshalling(small));
+    EXPECT_EQ(small.GetDataSize(), 0u);
+}
+
+/**
+* @tc.name: PasteDataWireTest001
+* @tc.desc: The UTF-8 layout round trips non-ASCII text and is sized exactly, the UTF-16 layout still decodes.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataWireTest001, TestSize.Level0)
+{
+    std::string html = "<p>\xe4\xbd\xa0\xe5\xa5\xbd \xf0\x9f\x98\x80</p>";
+    std::string text = "plain \xc3\xa9t\xc3\xa9";
+    PasteData data;
+    data.AddHtmlRecord(html);
+    data.AddTextRecord(text);
+    data.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    for (uint32_t version : { PASTE_DATA_WIRE_V1, PASTE_DATA_WIRE_V2 }) {
+        Parcel parcel;
+        ASSERT_TRUE(data.Marshalling(parcel, version));
+        EXPECT_EQ(parcel.GetDataSize(), data.SerializedSize(version));
+        std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel));
+        ASSERT_TRUE(decoded != nullptr);
+        ASSERT_TRUE(decoded->GetRecordCount() == 3);
+        ASSERT_TRUE(decoded->GetPrimaryHtml() != nullptr && decoded->GetPrimaryText() != nullptr);
+        EXPECT_EQ(*decoded->GetPrimaryHtml(), html);
+        EXPECT_EQ(*decoded->GetPrimaryText(), text);
+        ASSERT_TRUE(decoded->GetPrimaryUri() != nullptr);
+        EXPECT_EQ(decoded->GetPrimaryUri()->ToString(), "dataability:///com.example.test/1");
+    }
+    Parcel parcel;
+    VersionedPasteData versioned(data, PASTE_DATA_WIRE_V2);
+    ASSERT_TRUE(parcel.WriteParcelable(&versioned));
+    std::unique_ptr<PasteData> decoded(parcel.ReadParcelable<PasteData>());
+    ASSERT_TRUE(decoded != nullptr && decoded->GetRecordCount() == 3);
+}
+
+/**
+* @tc.name: PasteDataWireTest002
+* @tc.desc: V2 text that is not UTF-8 or not below the size cap is refused, read eagerly or lazily.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataWireTest002, TestSize.Level0)
+{
+    constexpr uint32_t v2Magic = 0x50445632;
+    const std::string mimeType = MIMETYPE_TEXT_PLAIN;
+    auto decode = [&mimeType](const std::string &text, bool lazy) {
+        Parcel parcel;
+        parcel.SetMaxCapacity(2 * PasteDataRecord::MAX_TEXT_SIZE);
+        parcel.WriteUint32(v2Magic);
+        parcel.WriteUint32(1);
+        parcel.WriteUint32(static_cast<uint32_t>(mimeType.size()));
+        parcel.WriteBuffer(mimeType.data(), mimeType.size());
+        parcel.WriteUint32(static_cast<uint32_t>(text.size()));
+        parcel.WriteBuffer(text.data(), text.size());
+        std::unique_ptr<PasteData> data(PasteData::Unmarshalling(parcel, lazy));
+        return (data == nullptr) ? nullptr : data->GetPrimaryText();
+    };
+    for (bool lazy : { false, true }) {
+        auto text = decode("\xe4\xbd\xa0 ok", lazy);
+        ASSERT_TRUE(text != nullptr);
+        EXPECT_EQ(*text, "\xe4\xbd\xa0 ok");
+        EXPECT_TRUE(decode(std::string(64, 'a') + "\xe4\xbd", lazy) == nullptr);
+        EXPECT_TRUE(decode("\xed\xa0\x80", lazy) == nullptr);
+        EXPECT_TRUE(decode(std::string(PasteDataRecord::MAX_TEXT_SIZE, 'a'), lazy) == nullptr);
+    }
+}
+
+/**
+* @tc.name: PasteDataInlineTest001
+* @tc.desc: A record of short text is a single allocation and converts like any other.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataInlineTest001, TestSize.Level0)
+{
+    std::string html = "<p>\xe4\xbd\xa0\xe5\xa5\xbd</p>";
+    std::string text = "a plain text longer than a short string";
+    g_allocs = 0;
+    auto htmlRecord = PasteDataRecord::NewHtmlRecord(std::move(html));
+    auto textRecord = PasteDataRecord::NewPlaintTextRecord(std::move(text));
+    EXPECT_EQ(g_allocs.load(), 2u);
+    ASSERT_TRUE(htmlRecord != nullptr && textRecord != nullptr);
+    ASSERT_TRUE(htmlRecord->GetHtmlText() != nullptr && textRecord->GetPlainText() != nullptr);
+    EXPECT_EQ(*htmlRecord->GetHtmlText(), "<p>\xe4\xbd\xa0\xe5\xa5\xbd</p>");
+    EXPECT_EQ(*textRecord->GetPlainText(), "a plain text longer than a short string");
+    EXPECT_TRUE(htmlRecord->GetPlainText() == nullptr && textRecord->GetUri() == nullptr);
+    EXPECT_EQ(textRecord->GetContentSize(), textRecord->GetPlainText()->size());
+
+    std::string uri = "dataability:///com.example.test/1";
+    auto uriRecord = PasteDataRecord::NewUriRecord(OHOS::Uri(uri));
+    ASSERT_TRUE(uriRecord != nullptr && uriRecord->GetUri() != nullptr);
+    EXPECT_EQ(uriRecord->GetUri()->ToString(), uri);
+    EXPECT_EQ(uriRecord->ConvertToText(), uri);
+    auto longUri = PasteDataRecord::NewUriRecord(OHOS::Uri(uri + std::string(64, 'x')));
+    ASSERT_TRUE(longUri != nullptr && longUri->GetUri() != nullptr);
+    EXPECT_EQ(longUri->GetUri()->ToString(), uri + std::string(64, 'x'));
+
+    // equal content is equal however it is held
+    auto heldText = std::make_shared<PasteDataRecord>(MIMETYPE_TEXT_PLAIN, nullptr, nullptr,
+        std::make_shared<std::string>("a plain text longer than a short string"), nullptr);
+    EXPECT_EQ(heldText->GetFingerprint(), textRecord->GetFingerprint());
+    for (uint32_t version : { PASTE_DATA_WIRE_V1, PASTE_DATA_WIRE_V2 }) {
+        Parcel parcel;
+        ASSERT_TRUE(textRecord->Marshalling(parcel, version));
+        EXPECT_EQ(parcel.GetDataSize(), textRecord->SerializedSize(version));
+        std::unique_ptr<PasteDataRecord> decoded(PasteDataRecord::Unmarshalling(parcel, version));
+        ASSERT_TRUE(decoded != nullptr && decoded->GetPlainText() != nullptr);
+        EXPECT_EQ(decoded->GetFingerprint(), textRecord->GetFingerprint());
+    }
+}
+
+/**
+* @tc.name: UtfTranscoderTest001
+* @tc.desc: Text with non-ASCII around the vector block edges converts both ways, ill-formed input is rejected.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, UtfTranscoderTest001, TestSize.Level0)
+{
+    std::string text;
+    for (std::size_t pad = 0; pad < 40; pad++) {
+        text += std::string(pad, 'a') + "\xc3\xa9\xe4\xbd\xa0\xf0\x9f\x98\x80";
+    }
+    std::u16string utf16;
+    ASSERT_TRUE(UtfTranscoder::Utf8ToUtf16(text, utf16));
+    EXPECT_TRUE(utf16 == Str8ToStr16(text));
+    std::string utf8;
+    ASSERT_TRUE(UtfTranscoder::Utf16ToUtf8(utf16, utf8));
+    EXPECT_EQ(utf8, text);
+
+    for (const char *bad : { "\xc0\xaf", "\xe0\x80\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xe4\xbd" }) {
+        EXPECT_FALSE(UtfTranscoder::Utf8ToUtf16(std::string(32, 'a') + bad, utf16));
+        EXPECT_TRUE(utf16.empty());
+    }
+    EXPECT_FALSE(UtfTranscoder::Utf16ToUtf8(std::u16string(32, u'a') + u'\xDC00', utf8));
+    EXPECT_TRUE(utf8.empty());
+
+    EXPECT_TRUE(UtfTranscoder::IsUtf8(text.data(), text.size()));
+    for (const char *bad : { "\xc0\xaf", "\xe0\x80\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xe4\xbd" }) {
+        std::string ill = std::string(40, 'a') + bad + std::string(40, 'a');
+        EXPECT_FALSE(UtfTranscoder::IsUtf8(ill.data(), ill.size()));
+    }
+}
+
+/**
+* @tc.name: PasteDataLazyTest001
+* @tc.desc: A lazy read decodes no text up front, records decode on first use and pass on unchanged.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataLazyTest001, TestSize.Level0)
+{
+    std::string text(PAYLOAD_SIZE, 'a');
+    std::string html = "<p>" + std::string(PAYLOAD_SIZE, 'b') + "</p>";
+    PasteData data;
+    data.AddTextRecord(text);
+    data.AddHtmlRecord(html);
+    data.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    for (uint32_t version : { PASTE_DATA_WIRE_V1, PASTE_DATA_WIRE_V2 }) {
+        Parcel parcel;
+        ASSERT_TRUE(parcel.SetMaxCapacity(data.SerializedSize(version)));
+        ASSERT_TRUE(data.Marshalling(parcel, version));
+
+        g_payloadAllocs = 0;
+        std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel, true));
+        // only the copy of the record bytes
+        EXPECT_EQ(g_payloadAllocs.load(), 1u);
+        ASSERT_TRUE(decoded != nullptr);
+        EXPECT_TRUE(decoded->GetRecordCount() == 3);
+        EXPECT_TRUE(decoded->HasMimeType(MIMETYPE_TEXT_PLAIN));
+        EXPECT_EQ(*decoded->GetPrimaryMimeType(), MIMETYPE_TEXT_URI);
+        ASSERT_TRUE(decoded->GetPrimaryText() != nullptr);
+        EXPECT_EQ(*decoded->GetPrimaryText(), text);
+        ASSERT_TRUE(decoded->GetRecordAt(1) != nullptr && decoded->GetRecordAt(1)->GetHtmlText() != nullptr);
+        EXPECT_EQ(*decoded->GetRecordAt(1)->GetHtmlText(), html);
+
+        ASSERT_TRUE(parcel.RewindRead(0));
+        std::unique_ptr<PasteData> lazy(PasteData::Unmarshalling(parcel, true));
+        ASSERT_TRUE(lazy != nullptr);
+        auto records = lazy->AllRecords();
+        ASSERT_TRUE(records.size() == 3 && records[0] != nullptr && records[0]->GetUri() != nullptr);
+        EXPECT_EQ(records[0]->GetUri()->ToString(), "dataability:///com.example.test/1");
+        Parcel forwarded;
+        ASSERT_TRUE(forwarded.SetMaxCapacity(parcel.GetDataSize()));
+        ASSERT_TRUE(lazy->Marshalling(forwarded, version));
+        ASSERT_EQ(forwarded.GetDataSize(), parcel.GetDataSize());
+        EXPECT_EQ(memcmp(reinterpret_cast<const void *>(forwarded.GetData()),
+            reinterpret_cast<const void *>(parcel.GetData()), parcel.GetDataSize()), 0);
+    }
+}
+
+/**
+* @tc.name: PasteDataParallelTest001
+* @tc.desc: A clip coded on the worker pool has the same bytes and records as one coded serially.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataParallelTest001, TestSize.Level0)
+{
+    PasteData data;
+    for (int i = 0; i < 8; i++) {
+        data.AddHtmlRecord("<li>" + std::to_string(i) + " \xe4\xbd\xa0\xe5\xa5\xbd</li>");
+    }
+    data.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    Parcel serial;
+    RecordTaskPool::GetInstance().SetMinBytes(std::numeric_limits<std::size_t>::max());
+    ASSERT_TRUE(data.Marshalling(serial));
+
+    RecordTaskPool::GetInstance().SetMinBytes(0);
+    Parcel parallel;
+    ASSERT_TRUE(data.Marshalling(parallel));
+    ASSERT_EQ(parallel.GetDataSize(), serial.GetDataSize());
+    EXPECT_EQ(memcmp(reinterpret_cast<const void *>(parallel.GetData()),
+        reinterpret_cast<const void *>(serial.GetData()), serial.GetDataSize()), 0);
+    std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parallel));
+    RecordTaskPool::GetInstance().SetMinBytes(256 * 1024);
+    ASSERT_TRUE(decoded != nullptr);
+    ASSERT_TRUE(decoded->GetRecordCount() == data.GetRecordCount());
+    for (std::size_t i = 0; i < data.GetRecordCount(); i++) {
+        EXPECT_EQ(decoded->GetRecordAt(i)->ConvertToText(), data.GetRecordAt(i)->ConvertToText());
+    }
+    EXPECT_TRUE(decoded->GetPrimaryUri() != nullptr);
+}
+
+/**
+* @tc.name: PasteDataParallelTest002
+* @tc.desc: A clip held encoded in V1, as the service keeps one a V1 peer set, is transcoded on the worker pool
+*           when written as V2 and when all its records are decoded, with the same result as serially.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataParallelTest002, TestSize.Level0)
+{
+    PasteData data;
+    for (int i = 0; i < 8; i++) {
+        data.AddTextRecord(std::to_string(i) + std::string(64, 'x') + " \xe4\xbd\xa0\xe5\xa5\xbd");
+    }
+    data.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    Parcel parcel;
+    ASSERT_TRUE(data.Marshalling(parcel, PASTE_DATA_WIRE_V1));
+    std::unique_ptr<PasteData> held(PasteData::Unmarshalling(parcel, true));
+    ASSERT_TRUE(held != nullptr && held->GetRecordCount() == data.GetRecordCount());
+
+    Parcel serial;
+    RecordTaskPool::GetInstance().SetMinBytes(std::numeric_limits<std::size_t>::max());
+    ASSERT_TRUE(data.Marshalling(serial, PASTE_DATA_WIRE_V2));
+    RecordTaskPool::GetInstance().SetMinBytes(0);
+    Parcel parallel;
+    bool written = held->Marshalling(parallel, PASTE_DATA_WIRE_V2);
+    auto records = held->AllRecords();
+    uint64_t fingerprint = held->GetFingerprint();
+    RecordTaskPool::GetInstance().SetMinBytes(256 * 1024);
+    ASSERT_TRUE(written);
+    ASSERT_EQ(parallel.GetDataSize(), serial.GetDataSize());
+    EXPECT_EQ(memcmp(reinterpret_cast<const void *>(parallel.GetData()),
+        reinterpret_cast<const void *>(serial.GetData()), serial.GetDataSize()), 0);
+    ASSERT_EQ(records.size(), data.GetRecordCount());
+    for (std::size_t i = 0; i < records.size(); i++) {
+        ASSERT_TRUE(records[i] != nullptr);
+        EXPECT_EQ(records[i]->ConvertToText(), data.GetRecordAt(i)->ConvertToText());
+    }
+    EXPECT_EQ(fingerprint, data.GetFingerprint());
+}
+
+/**
+* @tc.name: PasteDataFingerprintTest001
+* @tc.desc: Fingerprints follow type and content, and survive every wire version and a lazy read.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataFingerprintTest001, TestSize.Level0)
+{
+    auto plain = PasteboardClient::GetInstance()->CreatePlainTextRecord("fingerprint");
+    auto samePlain = PasteboardClient::GetInstance()->CreatePlainTextRecord("fingerprint");
+    auto html = PasteboardClient::GetInstance()->CreateHtmlTextRecord("fingerprint");
+    ASSERT_TRUE(plain != nullptr && samePlain != nullptr && html != nullptr);
+    EXPECT_EQ(plain->GetFingerprint(), samePlain->GetFingerprint());
+    EXPECT_NE(plain->GetFingerprint(), html->GetFingerprint());
+
+    PasteData data;
+    data.AddRecord(plain);
+    data.AddRecord(html);
+    data.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    uint64_t fingerprint = data.GetFingerprint();
+    for (uint32_t version : { PASTE_DATA_WIRE_V1, PASTE_DATA_WIRE_V2 }) {
+        for (bool lazy : { false, true }) {
+            Parcel parcel;
+            ASSERT_TRUE(parcel.SetMaxCapacity(data.SerializedSize(version)));
+            ASSERT_TRUE(data.Marshalling(parcel, version));
+            std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel, lazy));
+            ASSERT_TRUE(decoded != nullptr);
+            EXPECT_EQ(decoded->GetFingerprint(), fingerprint);
+            EXPECT_EQ(decoded->GetRecordAt(1)->GetFingerprint(), html->GetFingerprint());
+        }
+    }
+
+    PasteData reordered;
+    reordered.AddRecord(html);
+    reordered.AddRecord(plain);
+    reordered.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    EXPECT_NE(reordered.GetFingerprint(), fingerprint);
+    data.AddTextRecord("more");
+    EXPECT_NE(data.GetFingerprint(), fingerprint);
+}
+
+/**
+* @tc.name: PasteDataSharedTextTest001
+* @tc.desc: Large V3 text travels as a shared region that readers map without copying, older layouts inline it.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataSharedTextTest001, TestSize.Level0)
+{
+    std::string text(PAYLOAD_SIZE, 'a');
+    PasteData data;
+    data.AddHtmlRecord("<p>small</p>");
+    data.AddTextRecord(text);
+    uint64_t fingerprint = data.GetFingerprint();
+    Parcel parcel;
+    ASSERT_TRUE(data.Marshalling(parcel, PASTE_DATA_WIRE_V3));
+    EXPECT_LT(parcel.GetDataSize(), text.size());
+    EXPECT_LE(parcel.GetDataSize(), data.SerializedSize(PASTE_DATA_WIRE_V3));
+    for (bool lazy : { false, true }) {
+        ASSERT_TRUE(parcel.RewindRead(0));
+        g_payloadAllocs = 0;
+        std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel, lazy));
+        EXPECT_EQ(g_payloadAllocs.load(), 0u);
+        ASSERT_TRUE(decoded != nullptr && decoded->GetRecordCount() == 2);
+        EXPECT_EQ(decoded->GetFingerprint(), fingerprint);
+        ASSERT_TRUE(decoded->GetPrimaryText() != nullptr && decoded->GetPrimaryHtml() != nullptr);
+        EXPECT_EQ(*decoded->GetPrimaryText(), text);
+        EXPECT_EQ(*decoded->GetPrimaryHtml(), "<p>small</p>");
+
+        // passed on in shared memory again, or inline to a peer without V3
+        Parcel shared;
+        ASSERT_TRUE(decoded->Marshalling(shared, PASTE_DATA_WIRE_V3));
+        EXPECT_LT(shared.GetDataSize(), text.size());
+        Parcel inlined;
+        ASSERT_TRUE(inlined.SetMaxCapacity(decoded->SerializedSize(PASTE_DATA_WIRE_V2)));
+        ASSERT_TRUE(decoded->Marshalling(inlined, PASTE_DATA_WIRE_V2));
+        std::unique_ptr<PasteData> copied(PasteData::Unmarshalling(inlined));
+        ASSERT_TRUE(copied != nullptr && copied->GetPrimaryText() != nullptr);
+        EXPECT_EQ(*copied->GetPrimaryText(), text);
+    }
+}
+
+/**
+* @tc.name: PasteDataSharedTextTest002
+* @tc.desc: A region the sender can still write to is refused, whether it is unsealed or sealed against
+*           everything but writes while the sender keeps a writable mapping. Regions sent are fully sealed.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataSharedTextTest002, TestSize.Level0)
+{
+    constexpr uint32_t v3Magic = 0x50445633;
+    constexpr uint32_t sharedMarker = 0xFFFFFFFF;
+    const std::string mimeType = MIMETYPE_TEXT_PLAIN;
+    const std::string text = "unsealed";
+    for (bool sealOthers : { false, true }) {
+        int fd = memfd_create("PasteDataTest", MFD_ALLOW_SEALING);
+        ASSERT_TRUE(fd >= 0 && ftruncate(fd, static_cast<off_t>(text.size())) == 0);
+        void *mapped = mmap(nullptr, text.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ASSERT_TRUE(mapped != MAP_FAILED);
+        memcpy(mapped, text.data(), text.size());
+        if (sealOthers) {
+            // the writable mapping keeps the kernel from sealing writes
+            EXPECT_NE(fcntl(fd, F_ADD_SEALS, F_SEAL_WRITE), 0);
+            ASSERT_EQ(fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL), 0);
+        }
+
+        Parcel parcel;
+        ASSERT_TRUE(parcel.WriteUint32(v3Magic) && parcel.WriteUint32(1));
+        ASSERT_TRUE(parcel.WriteUint32(static_cast<uint32_t>(mimeType.size())) &&
+            parcel.WriteBuffer(mimeType.data(), mimeType.size()));
+        ASSERT_TRUE(parcel.WriteUint32(sharedMarker) && parcel.WriteUint32(static_cast<uint32_t>(text.size())));
+        sptr<IPCFileDescriptor> descriptor = new IPCFileDescriptor(dup(fd));
+        ASSERT_TRUE(parcel.WriteObject<IPCFileDescriptor>(descriptor));
+        std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel));
+        EXPECT_TRUE(decoded == nullptr);
+        munmap(mapped, text.size());
+        close(fd);
+    }
+
+    std::string large(PAYLOAD_SIZE, 'a');
+    auto shared = SharedText::Create(large.data(), large.size());
+    ASSERT_TRUE(shared != nullptr);
+    Parcel parcel;
+    ASSERT_TRUE(shared->Marshalling(parcel));
+    ASSERT_TRUE(parcel.ReadUint32() == large.size());
+    sptr<IPCFileDescriptor> descriptor = parcel.ReadObject<IPCFileDescriptor>();
+    ASSERT_TRUE(descriptor != nullptr);
+    int fd = descriptor->GetFd();
+    constexpr int allSeals = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+    EXPECT_EQ(fcntl(fd, F_GET_SEALS) & allSeals, allSeals);
+    EXPECT_TRUE(mmap(nullptr, large.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) == MAP_FAILED);
+    EXPECT_TRUE(write(fd, "b", 1) < 0);
+}
+
+/**
+* @tc.name: PasteDataSharedTextTest003
+* @tc.desc: Text appended in chunks is sealed into a region and held by a record as it is.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataSharedTextTest003, TestSize.Level0)
+{
+    std::string text;
+    while (text.size() < PAYLOAD_SIZE) {
+        text += "chunk \xe4\xbd\xa0\xe5\xa5\xbd ";
+    }
+    EXPECT_TRUE(SharedTextBuilder::Create(0) == nullptr);
+    auto builder = SharedTextBuilder::Create(text.size());
+    ASSERT_TRUE(builder != nullptr);
+    constexpr std::size_t chunkSize = 1000;
+    for (std::size_t offset = 0; offset < text.size(); offset += chunkSize) {
+        ASSERT_TRUE(builder->Append(text.data() + offset, std::min(chunkSize, text.size() - offset)));
+    }
+    EXPECT_EQ(builder->GetSize(), text.size());
+    EXPECT_TRUE(!builder->Append("x", 1));
+    auto shared = builder->Seal();
+    ASSERT_TRUE(shared != nullptr);
+    EXPECT_TRUE(builder->Seal() == nullptr);
+    EXPECT_EQ(std::string(shared->GetData(), shared->GetSize()), text);
+
+    EXPECT_TRUE(PasteDataRecord::NewSharedTextRecord(MIMETYPE_TEXT_URI, shared) == nullptr);
+    EXPECT_TRUE(PasteDataRecord::NewSharedTextRecord(MIMETYPE_TEXT_PLAIN, nullptr) == nullptr);
+    auto record = PasteDataRecord::NewSharedTextRecord(MIMETYPE_TEXT_HTML, shared);
+    ASSERT_TRUE(record != nullptr);
+    EXPECT_EQ(record->GetMimeType(), MIMETYPE_TEXT_HTML);
+    EXPECT_EQ(record->GetContentSize(), text.size());
+    ASSERT_TRUE(record->GetHtmlText() != nullptr);
+    EXPECT_EQ(*record->GetHtmlText(), text);
+
+    // a receiver refuses writable regions, so decoding it also proves the seal
+    PasteData data;
+    data.AddRecord(record);
+    Parcel parcel;
+    ASSERT_TRUE(data.Marshalling(parcel, PASTE_DATA_WIRE_V3));
+    EXPECT_LT(parcel.GetDataSize(), text.size());
+    std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel));
+    ASSERT_TRUE(decoded != nullptr && decoded->GetPrimaryHtml() != nullptr);
+    EXPECT_EQ(*decoded->GetPrimaryHtml(), text);
+    EXPECT_EQ(decoded->GetFingerprint(), data.GetFingerprint());
+}
+
+/**
+* @tc.name: PasteDataSharedTextTest004
+* @tc.desc: A sealed region is refused when it announces text past the record cap, or when it is larger
+*           than the size it announces. A region of exactly its announced size is accepted.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataSharedTextTest004, TestSize.Level0)
+{
+    constexpr uint32_t v3Magic = 0x50445633;
+    constexpr uint32_t sharedMarker = 0xFFFFFFFF;
+    constexpr int allSeals = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+    const std::string mimeType = MIMETYPE_TEXT_PLAIN;
+    auto decode = [&mimeType](std::size_t regionSize, uint32_t announced) {
+        int fd = memfd_create("PasteDataTest", MFD_ALLOW_SEALING);
+        EXPECT_TRUE(fd >= 0 && ftruncate(fd, static_cast<off_t>(regionSize)) == 0);
+        std::string text(regionSize, 'a');
+        EXPECT_EQ(write(fd, text.data(), text.size()), static_cast<ssize_t>(text.size()));
+        EXPECT_EQ(fcntl(fd, F_ADD_SEALS, allSeals), 0);
+        Parcel parcel;
+        parcel.WriteUint32(v3Magic);
+        parcel.WriteUint32(1);
+        parcel.WriteUint32(static_cast<uint32_t>(mimeType.size()));
+        parcel.WriteBuffer(mimeType.data(), mimeType.size());
+        parcel.WriteUint32(sharedMarker);
+        parcel.WriteUint32(announced);
+        sptr<IPCFileDescriptor> descriptor = new IPCFileDescriptor(fd);
+        parcel.WriteObject<IPCFileDescriptor>(descriptor);
+        return std::unique_ptr<PasteData>(PasteData::Unmarshalling(parcel));
+    };
+    constexpr uint32_t maxSize = PasteDataRecord::MAX_TEXT_SIZE;
+    EXPECT_TRUE(decode(maxSize, maxSize) == nullptr);
+    EXPECT_TRUE(decode(4 * maxSize, maxSize - 1) == nullptr);
+    EXPECT_TRUE(decode(PAYLOAD_SIZE + 1, PAYLOAD_SIZE) == nullptr);
+    auto decoded = decode(PAYLOAD_SIZE, PAYLOAD_SIZE);
+    ASSERT_TRUE(decoded != nullptr && decoded->GetPrimaryText() != nullptr);
+    EXPECT_EQ(*decoded->GetPrimaryText(), std::string(PAYLOAD_SIZE, 'a'));
+}
+
+/**
+* @tc.name: PasteDataContentSizeTest001
+* @tc.desc: A clip read lazily knows its content size without decoding, in every layout.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataContentSizeTest001, TestSize.Level0)
+{
+    std::string html = "<p>\xe4\xbd\xa0\xe5\xa5\xbd \xf0\x9f\x98\x80</p>" + std::string(PAYLOAD_SIZE, 'b');
+    std::string text = "plain \xc3\xa9t\xc3\xa9";
+    std::string uri = "dataability:///com.example.test/1";
+    PasteData data;
+    data.AddHtmlRecord(html);
+    data.AddTextRecord(text);
+    data.AddUriRecord(OHOS::Uri(uri));
+    uint64_t size = html.size() + text.size() + uri.size();
+    EXPECT_EQ(data.GetContentSize(), size);
+    for (uint32_t version : { PASTE_DATA_WIRE_V1, PASTE_DATA_WIRE_V2, PASTE_DATA_WIRE_V3 }) {
+        Parcel parcel;
+        ASSERT_TRUE(parcel.SetMaxCapacity(data.SerializedSize(version)));
+        ASSERT_TRUE(data.Marshalling(parcel, version));
+        g_payloadAllocs = 0;
+        std::unique_ptr<PasteData> lazy(PasteData::Unmarshalling(parcel, true));
+        ASSERT_TRUE(lazy != nullptr);
+        EXPECT_EQ(lazy->GetContentSize(), size);
+        // at most the copy of the record bytes, the html of V3 stays in its region
+        EXPECT_LE(g_payloadAllocs.load(), 1u);
+    }
+}
+
+/**
+* @tc.name: PasteDataSummaryTest001
+* @tc.desc: The property lists the mime types in record order and the summary survives a parcel.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataSummaryTest001, TestSize.Level0)
+{
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    PasteData data({ PasteDataRecord::NewHtmlRecord("<p>html</p>"), PasteDataRecord::NewPlaintTextRecord("text") });
+    PasteDataSummary summary;
+    summary.property = data.GetProperty();
+    ASSERT_TRUE(summary.property.mimeTypes.size() == 2);
+    EXPECT_EQ(summary.property.mimeTypes[0], MIMETYPE_TEXT_HTML);
+    EXPECT_EQ(summary.property.mimeTypes[1], MIMETYPE_TEXT_PLAIN);
+    EXPECT_GE(summary.property.timestamp, now);
+    EXPECT_FALSE(summary.property.localOnly);
+    summary.property.tag = "tag";
+    summary.recordSizes = { 11, 4 };
+
+    Parcel parcel;
+    ASSERT_TRUE(summary.Marshalling(parcel));
+    std::unique_ptr<PasteDataSummary> decoded(PasteDataSummary::Unmarshalling(parcel));
+    ASSERT_TRUE(decoded != nullptr);
+    EXPECT_EQ(decoded->property.mimeTypes, summary.property.mimeTypes);
+    EXPECT_EQ(decoded->property.tag, "tag");
+    EXPECT_EQ(decoded->property.timestamp, summary.property.timestamp);
+    EXPECT_EQ(decoded->recordSizes, summary.recordSizes);
+}
+
+/**
+* @tc.name: PasteDataPeekTest001
+* @tc.desc: A record peeked from a lazily read clip is passed on alone without being decoded.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataPeekTest001, TestSize.Level0)
+{
+    std::string text(PAYLOAD_SIZE, 'a');
+    std::string html = "<p>" + std::string(PAYLOAD_SIZE, 'b') + "</p>";
+    PasteData data;
+    data.AddTextRecord(text);
+    data.AddHtmlRecord(html);
+    data.AddUriRecord(OHOS::Uri("dataability:///com.example.test/1"));
+    Parcel parcel;
+    ASSERT_TRUE(parcel.SetMaxCapacity(data.SerializedSize(PASTE_DATA_WIRE_V2)));
+    ASSERT_TRUE(data.Marshalling(parcel, PASTE_DATA_WIRE_V2));
+    std::unique_ptr<PasteData> lazy(PasteData::Unmarshalling(parcel, true));
+    ASSERT_TRUE(lazy != nullptr);
+    EXPECT_TRUE(lazy->PeekRecordAt(3) == nullptr);
+    EXPECT_TRUE(lazy->PeekFirstRecord("text/unknown") == nullptr);
+
+    g_payloadAllocs = 0;
+    auto record = lazy->PeekFirstRecord(MIMETYPE_TEXT_HTML);
+    ASSERT_TRUE(record != nullptr);
+    EXPECT_EQ(record, lazy->PeekRecordAt(1));
+    EXPECT_EQ(record->GetMimeType(), MIMETYPE_TEXT_HTML);
+    EXPECT_EQ(record->GetContentSize(), html.size());
+    PasteData single;
+    single.AddRecord(record);
+    Parcel forwarded;
+    ASSERT_TRUE(forwarded.SetMaxCapacity(single.SerializedSize(PASTE_DATA_WIRE_V2)));
+    ASSERT_TRUE(single.Marshalling(forwarded, PASTE_DATA_WIRE_V2));
+    // only the buffer of the outgoing parcel
+    EXPECT_EQ(g_payloadAllocs.load(), 1u);
+
+    std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(forwarded));
+    ASSERT_TRUE(decoded != nullptr && decoded->GetRecordCount() == 1);
+    ASSERT_TRUE(decoded->GetPrimaryHtml() != nullptr);
+    EXPECT_EQ(*decoded->GetPrimaryHtml(), html);
+}
+
+/**
+* @tc.name: PasteDataContentTest001
+* @tc.desc: The content of a record is read in place when held as UTF-8 or in shared memory, lazily read too.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteDataTest, PasteDataContentTest001, TestSize.Level0)
+{
+    std::string text = "\xe4\xbd\xa0\xe5\xa5\xbd" + std::string(PAYLOAD_SIZE, 'a');
+    std::string uri = "dataability:///com.example.test/1";
+    PasteData data;
+    data.AddTextRecord(text);
+    data.AddUriRecord(OHOS::Uri(uri));
+    for (uint32_t version : { PASTE_DATA_WIRE_V2, PASTE_DATA_WIRE_V3 }) {
+        Parcel parcel;
+        ASSERT_TRUE(parcel.SetMaxCapacity(data.SerializedSize(version)));
+        ASSERT_TRUE(data.Marshalling(parcel, version));
+        std::unique_ptr<PasteData> lazy(PasteData::Unmarshalling(parcel, true));
+        ASSERT_TRUE(lazy != nullptr && lazy->GetRecordCount() == 2);
+
+        std::shared_ptr<const void> owner;
+        g_payloadAllocs = 0;
+        auto content = lazy->PeekRecordAt(1)->GetContent(owner);
+        // the record bytes and the text a lazily read record decodes into, none for text in shared memory
+        EXPECT_EQ(g_payloadAllocs.load(), (version == PASTE_DATA_WIRE_V3) ? 0u : 2u);
+        EXPECT_EQ(content, text);
+        EXPECT_EQ(content.size(), lazy->PeekRecordAt(1)->GetContentSize());
+        EXPECT_EQ(lazy->PeekRecordAt(0)->GetContent(owner), uri);
+    }
+
+    std::shared_ptr<const void> owner;
+    auto record = PasteDataRecord::NewPlaintTextRecord(text);
+    auto content = record->GetContent(owner);
+    EXPECT_EQ(content.data(), record->GetPlainText()->data());
+}
+}
@@ -212,4 +212,293 @@ HWTEST_F(PasteboardServiceTest, PasteDataTest004, TestSize.Level0)
     auto record = pasteData.GetPrimaryHtml();
     EXPECT_TRUE(record != nullptr);
 }
+
+/**
+* @tc.name: PasteboardChangedEventTest001
+* @tc.desc: Marshalling and unmarshalling of pasteboard changed event.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteboardChangedEventTest001, TestSize.Level0)
+{
+    PasteboardChangedEvent event;
+    event.seq = 3;
+    event.mimeTypes = { MIMETYPE_TEXT_PLAIN, MIMETYPE_TEXT_HTML };
+    event.recordCount = 2;
+    event.totalBytes = 20;
+    event.bundleName = "com.pasteboard.test";
+    event.timestamp = 1000;
+    Parcel parcel;
+    EXPECT_TRUE(event.Marshalling(parcel));
+    std::unique_ptr<PasteboardChangedEvent> result(PasteboardChangedEvent::Unmarshalling(parcel));
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_EQ(result->seq, event.seq);
+    EXPECT_EQ(result->mimeTypes, event.mimeTypes);
+    EXPECT_EQ(result->recordCount, event.recordCount);
+    EXPECT_EQ(result->totalBytes, event.totalBytes);
+    EXPECT_EQ(result->bundleName, event.bundleName);
+    EXPECT_EQ(result->timestamp, event.timestamp);
+}
+
+/**
+* @tc.name: PasteDataTest005
+* @tc.desc: Get paste data only when the change count moved.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest005, TestSize.Level0)
+{
+    std::string text = "plain text";
+    auto data = PasteboardClient::GetInstance()->CreatePlainTextData(text);
+    EXPECT_TRUE(data != nullptr);
+    PasteboardClient::GetInstance()->SetPasteData(*data);
+    auto changeCount = PasteboardClient::GetInstance()->GetChangeCount();
+    EXPECT_TRUE(changeCount > 0);
+
+    int64_t lastCount = changeCount - 1;
+    PasteData pasteData;
+    bool modified = false;
+    auto ok = PasteboardClient::GetInstance()->GetPasteDataIfChanged(lastCount, pasteData, modified);
+    EXPECT_TRUE(ok == true);
+    EXPECT_TRUE(modified == true);
+    EXPECT_EQ(lastCount, changeCount);
+    EXPECT_TRUE(pasteData.GetPrimaryText() != nullptr);
+
+    PasteData unchanged;
+    ok = PasteboardClient::GetInstance()->GetPasteDataIfChanged(lastCount, unchanged, modified);
+    EXPECT_TRUE(ok == true);
+    EXPECT_TRUE(modified != true);
+    EXPECT_TRUE(unchanged.GetRecordCount() == 0);
+
+    PasteboardClient::GetInstance()->Clear();
+    EXPECT_TRUE(PasteboardClient::GetInstance()->GetChangeCount() > changeCount);
+}
+
+/**
+* @tc.name: PasteDataTest006
+* @tc.desc: Record order and mime index across add, remove, replace and parcel round trip.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest006, TestSize.Level0)
+{
+    PasteData data;
+    data.AddTextRecord("plain text");
+    data.AddHtmlRecord("<p>html</p>");
+    EXPECT_TRUE(data.GetRecordCount() == 2);
+    EXPECT_TRUE(data.HasMimeType(MIMETYPE_TEXT_PLAIN));
+    EXPECT_TRUE(*data.GetPrimaryMimeType() == MIMETYPE_TEXT_HTML);
+
+    Parcel parcel;
+    EXPECT_TRUE(data.Marshalling(parcel));
+    std::unique_ptr<PasteData> result(PasteData::Unmarshalling(parcel));
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_EQ(result->GetMimeTypes(), data.GetMimeTypes());
+
+    EXPECT_TRUE(result->RemoveRecordAt(1));
+    EXPECT_TRUE(result->GetRecordCount() == 1);
+    EXPECT_TRUE(!result->HasMimeType(MIMETYPE_TEXT_PLAIN));
+    EXPECT_TRUE(result->ReplaceRecordAt(0, PasteDataRecord::NewPlaintTextRecord("text")));
+    EXPECT_TRUE(result->HasMimeType(MIMETYPE_TEXT_PLAIN));
+    EXPECT_TRUE(!result->HasMimeType(MIMETYPE_TEXT_HTML));
+}
+
+/**
+* @tc.name: PasteDataTest007
+* @tc.desc: Primary lookups follow the newest record of each type, also past the record limit.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest007, TestSize.Level0)
+{
+    PasteData data;
+    data.AddTextRecord("oldest");
+    data.AddHtmlRecord("<p>html</p>");
+    for (int i = 0; i < 130; i++) {
+        data.AddTextRecord(std::to_string(i));
+    }
+    EXPECT_TRUE(data.GetRecordCount() == 128);
+    EXPECT_TRUE(*data.GetPrimaryText() == "129");
+    EXPECT_TRUE(data.GetPrimaryHtml() == nullptr);
+    EXPECT_TRUE(!data.HasMimeType(MIMETYPE_TEXT_HTML));
+    EXPECT_TRUE(!data.HasMimeType("unknown/type"));
+
+    EXPECT_TRUE(data.ReplaceRecordAt(3, PasteDataRecord::NewHtmlRecord("<p>new</p>")));
+    EXPECT_TRUE(*data.GetPrimaryHtml() == "<p>new</p>");
+    EXPECT_TRUE(data.RemoveRecordAt(0));
+    EXPECT_TRUE(*data.GetPrimaryText() == "128");
+}
+
+/**
+* @tc.name: PasteDataTest008
+* @tc.desc: Get the summary and single records of the paste data without fetching all of it.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest008, TestSize.Level0)
+{
+    std::string text = "plain text";
+    std::string html = "<p>html</p>";
+    auto data = PasteboardClient::GetInstance()->CreatePlainTextData(text);
+    EXPECT_TRUE(data != nullptr);
+    data->AddHtmlRecord(html);
+    PasteboardClient::GetInstance()->SetPasteData(*data);
+
+    PasteDataSummary summary;
+    EXPECT_TRUE(PasteboardClient::GetInstance()->GetPasteDataSummary(summary));
+    ASSERT_TRUE(summary.property.mimeTypes.size() == 2);
+    EXPECT_EQ(summary.property.mimeTypes[0], MIMETYPE_TEXT_HTML);
+    ASSERT_TRUE(summary.recordSizes.size() == 2);
+    EXPECT_EQ(summary.recordSizes[0], html.size());
+    EXPECT_EQ(summary.recordSizes[1], text.size());
+    EXPECT_TRUE(summary.property.timestamp > 0);
+
+    auto record = PasteboardClient::GetInstance()->GetRecordAt(1);
+    ASSERT_TRUE(record != nullptr && record->GetPlainText() != nullptr);
+    EXPECT_EQ(*record->GetPlainText(), text);
+    record = PasteboardClient::GetInstance()->GetFirstRecord(MIMETYPE_TEXT_HTML);
+    ASSERT_TRUE(record != nullptr && record->GetHtmlText() != nullptr);
+    EXPECT_EQ(*record->GetHtmlText(), html);
+    EXPECT_TRUE(PasteboardClient::GetInstance()->GetRecordAt(2) == nullptr);
+    EXPECT_TRUE(PasteboardClient::GetInstance()->GetFirstRecord(MIMETYPE_TEXT_URI) == nullptr);
+}
+
+/**
+* @tc.name: PasteDataTest009
+* @tc.desc: Read a record in chunks that end on character boundaries.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest009, TestSize.Level0)
+{
+    std::string text;
+    for (int i = 0; i < 1000; i++) {
+        text += "a\xe4\xbd\xa0\xf0\x9f\x98\x80";
+    }
+    auto data = PasteboardClient::GetInstance()->CreatePlainTextData(text);
+    EXPECT_TRUE(data != nullptr);
+    PasteboardClient::GetInstance()->SetPasteData(*data);
+
+    std::string mimeType;
+    uint64_t size = 0;
+    auto client = PasteboardClient::GetInstance();
+    EXPECT_TRUE(client->OpenRecordReader(1, mimeType, size) == 0);
+    uint32_t readerId = client->OpenRecordReader(0, mimeType, size);
+    ASSERT_TRUE(readerId != 0);
+    EXPECT_EQ(mimeType, MIMETYPE_TEXT_PLAIN);
+    EXPECT_EQ(size, text.size());
+    // a newer clip does not change what the reader reads
+    PasteboardClient::GetInstance()->Clear();
+
+    std::string content;
+    std::string chunk;
+    do {
+        ASSERT_TRUE(client->ReadRecordChunk(readerId, content.size(), 7, chunk));
+        EXPECT_TRUE(chunk.size() <= 7);
+        EXPECT_TRUE(chunk.empty() || (static_cast<unsigned char>(chunk[0]) & 0xC0) != 0x80);
+        content += chunk;
+    } while (!chunk.empty());
+    EXPECT_EQ(content, text);
+    EXPECT_TRUE(!client->ReadRecordChunk(readerId, size + 1, 7, chunk));
+    client->CloseRecordReader(readerId);
+    EXPECT_TRUE(!client->ReadRecordChunk(readerId, 0, 7, chunk));
+}
+
+/**
+* @tc.name: PasteDataTest010
+* @tc.desc: A copy written in chunks is published as a whole on commit, nothing of an aborted one.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest010, TestSize.Level0)
+{
+    std::string html = "<p>small</p>";
+    std::string text(300 * 1024, 'a');
+    auto client = PasteboardClient::GetInstance();
+    client->Clear();
+    // a refused record fails the writer
+    uint32_t writerId = client->BeginPasteWriter();
+    ASSERT_TRUE(writerId != 0);
+    EXPECT_TRUE(!client->AddWriterRecord(writerId, MIMETYPE_TEXT_URI, 1));
+    EXPECT_TRUE(!client->CommitPasteWriter(writerId));
+
+    // a writer holding a complete record cannot be committed once aborted, and publishes nothing
+    writerId = client->BeginPasteWriter();
+    ASSERT_TRUE(writerId != 0);
+    ASSERT_TRUE(client->AddWriterRecord(writerId, MIMETYPE_TEXT_HTML, html.size()));
+    ASSERT_TRUE(client->WriteRecordChunk(writerId, html.data(), html.size()));
+    client->AbortPasteWriter(writerId);
+    EXPECT_TRUE(!client->CommitPasteWriter(writerId));
+    EXPECT_TRUE(!client->HasPasteData());
+
+    writerId = client->BeginPasteWriter();
+    ASSERT_TRUE(writerId != 0);
+    ASSERT_TRUE(client->AddWriterRecord(writerId, MIMETYPE_TEXT_PLAIN, text.size()));
+    ASSERT_TRUE(client->WriteRecordChunk(writerId, text.data(), text.size()));
+    ASSERT_TRUE(client->AddWriterRecord(writerId, MIMETYPE_TEXT_HTML, html.size()));
+    ASSERT_TRUE(client->WriteRecordChunk(writerId, html.data(), html.size()));
+    EXPECT_TRUE(!client->HasPasteData());
+    ASSERT_TRUE(client->CommitPasteWriter(writerId));
+    EXPECT_TRUE(!client->CommitPasteWriter(writerId));
+
+    PasteData data;
+    ASSERT_TRUE(client->GetPasteData(data));
+    ASSERT_EQ(data.GetRecordCount(), 2u);
+    ASSERT_TRUE(data.GetPrimaryText() != nullptr && data.GetPrimaryHtml() != nullptr);
+    EXPECT_EQ(*data.GetPrimaryText(), text);
+    EXPECT_EQ(*data.GetPrimaryHtml(), html);
+    ASSERT_TRUE(data.GetPrimaryMimeType() != nullptr);
+    EXPECT_EQ(*data.GetPrimaryMimeType(), MIMETYPE_TEXT_PLAIN);
+
+    // a record short of its size fails the commit and leaves the clip as it was
+    writerId = client->BeginPasteWriter();
+    ASSERT_TRUE(client->AddWriterRecord(writerId, MIMETYPE_TEXT_PLAIN, html.size() + 1));
+    ASSERT_TRUE(client->WriteRecordChunk(writerId, html.data(), html.size()));
+    EXPECT_TRUE(!client->CommitPasteWriter(writerId));
+    ASSERT_TRUE(client->GetPasteData(data));
+    EXPECT_EQ(data.GetRecordCount(), 2u);
+}
+
+/**
+* @tc.name: PasteDataTest011
+* @tc.desc: Beginning a third writer aborts the oldest one of the same process, the others stay usable.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest011, TestSize.Level0)
+{
+    auto client = PasteboardClient::GetInstance();
+    uint32_t first = client->BeginPasteWriter();
+    uint32_t second = client->BeginPasteWriter();
+    uint32_t third = client->BeginPasteWriter();
+    ASSERT_TRUE(first != 0 && second != 0 && third != 0);
+    EXPECT_TRUE(!client->AddWriterRecord(first, MIMETYPE_TEXT_PLAIN, 1));
+    EXPECT_TRUE(client->AddWriterRecord(second, MIMETYPE_TEXT_PLAIN, 1));
+    EXPECT_TRUE(client->AddWriterRecord(third, MIMETYPE_TEXT_PLAIN, 1));
+    client->AbortPasteWriter(second);
+    client->AbortPasteWriter(third);
+}
+
+/**
+* @tc.name: PasteDataTest012
+* @tc.desc: Reads shorter than a character still return whole characters.
+* @tc.type: FUNC
+*/
+HWTEST_F(PasteboardServiceTest, PasteDataTest012, TestSize.Level0)
+{
+    std::string text = "a\xc3\xa9\xe4\xbd\xa0\xf0\x9f\x98\x80" "b";
+    auto client = PasteboardClient::GetInstance();
+    auto data = client->CreatePlainTextData(text);
+    ASSERT_TRUE(data != nullptr);
+    client->SetPasteData(*data);
+    for (uint32_t length = 1; length < 4; length++) {
+        std::string mimeType;
+        uint64_t size = 0;
+        uint32_t readerId = client->OpenRecordReader(0, mimeType, size);
+        ASSERT_TRUE(readerId != 0);
+        std::string content;
+        std::string chunk;
+        do {
+            ASSERT_TRUE(client->ReadRecordChunk(readerId, content.size(), length, chunk));
+            EXPECT_TRUE(chunk.empty() || (static_cast<unsigned char>(chunk[0]) & 0xC0) != 0x80);
+            EXPECT_TRUE(content.size() + chunk.size() == text.size() ||
+                (static_cast<unsigned char>(text[content.size() + chunk.size()]) & 0xC0) != 0x80);
+            content += chunk;
+        } while (!chunk.empty());
+        EXPECT_EQ(content, text);
+        client->CloseRecordReader(readerId);
+    }
+}
 }
@@ -32,6 +32,8 @@ public:
     ~PasteboardObserverProxy() = default;
     DISALLOW_COPY_AND_MOVE(PasteboardObserverProxy);
     void OnPasteboardChanged() override;
+    void OnPasteboardChanged(const PasteboardChangedEvent &event) override;
+    bool SendPasteboardChanged(const PasteboardChangedEvent &event) override;
 private:
     static inline BrokerDelegator<PasteboardObserverProxy> delegator_;
 };
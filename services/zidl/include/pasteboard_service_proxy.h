@@ -16,6 +16,7 @@
 #ifndef PASTE_BOARD_SERVICE_PROXY_H
 #define PASTE_BOARD_SERVICE_PROXY_H
 
+#include <atomic>
 #include "i_pasteboard_observer.h"
 #include "i_pasteboard_service.h"
 #include "iremote_proxy.h"
@@ -31,12 +32,34 @@ public:
     virtual bool GetPasteData(PasteData& data) override;
     virtual bool HasPasteData() override;
     virtual void SetPasteData(PasteData& pasteData) override;
-    virtual void AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer) override;
+    virtual void AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer,
+        const std::vector<std::string> &mimeTypes) override;
     virtual void RemovePasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer) override;
     virtual void RemoveAllChangedObserver() override;
+    virtual void AddPasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer) override;
+    virtual void RemovePasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer) override;
+    virtual int64_t GetChangeCount() override;
+    virtual bool GetPasteDataIfChanged(int64_t &changeCount, PasteData &data, bool &modified) override;
+    virtual bool GetPasteDataSummary(PasteDataSummary &summary) override;
+    virtual bool GetRecordAt(uint32_t index, PasteData &data) override;
+    virtual bool GetFirstRecord(const std::string &mimeType, PasteData &data) override;
+    virtual uint32_t OpenRecordReader(uint32_t index, const sptr<IRemoteObject> &token, std::string &mimeType,
+        uint64_t &size) override;
+    virtual bool ReadRecordChunk(uint32_t readerId, uint64_t offset, uint32_t length, std::string &chunk) override;
+    virtual void CloseRecordReader(uint32_t readerId) override;
+    virtual uint32_t BeginPasteWriter(const sptr<IRemoteObject> &token) override;
+    virtual bool AddWriterRecord(uint32_t writerId, const std::string &mimeType, uint64_t size) override;
+    virtual bool AppendWriterChunk(uint32_t writerId, const char *data, std::size_t size) override;
+    virtual bool CommitPasteWriter(uint32_t writerId) override;
+    virtual void AbortPasteWriter(uint32_t writerId) override;
 
 private:
+    bool ReadRecordReply(MessageParcel &reply, PasteData &pasteData);
+    bool SendWriterRequest(uint32_t code, MessageParcel &data);
+
     static inline BrokerDelegator<PasteboardServiceProxy> delegator_;
+    // Paste data layout for SET, raised once the service reports it understands a newer one.
+    std::atomic<uint32_t> wireVersion_ { PASTE_DATA_WIRE_V1 };
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -41,6 +41,22 @@ private:
     int32_t OnAddPasteboardChangedObserver(MessageParcel &data, MessageParcel &reply);
     int32_t OnRemovePasteboardChangedObserver(MessageParcel &data, MessageParcel &reply);
     int32_t OnRemoveAllChangedObserver(MessageParcel &data, MessageParcel &reply);
+    int32_t OnAddPasteboardEventObserver(MessageParcel &data, MessageParcel &reply);
+    int32_t OnRemovePasteboardEventObserver(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetChangeCount(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetPasteDataIfChanged(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetPasteDataSummary(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetRecordAt(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetFirstRecord(MessageParcel &data, MessageParcel &reply);
+    int32_t OnOpenRecordReader(MessageParcel &data, MessageParcel &reply);
+    int32_t OnReadRecordChunk(MessageParcel &data, MessageParcel &reply);
+    int32_t OnCloseRecordReader(MessageParcel &data, MessageParcel &reply);
+    int32_t OnBeginPasteWriter(MessageParcel &data, MessageParcel &reply);
+    int32_t OnAddWriterRecord(MessageParcel &data, MessageParcel &reply);
+    int32_t OnAppendWriterChunk(MessageParcel &data, MessageParcel &reply);
+    int32_t OnCommitPasteWriter(MessageParcel &data, MessageParcel &reply);
+    int32_t OnAbortPasteWriter(MessageParcel &data, MessageParcel &reply);
+    int32_t WriteRecordReply(bool found, PasteData &pasteData, uint32_t version, MessageParcel &reply);
 
     std::map<uint32_t, PasteboardServiceFunc> memberFuncMap_;
 };
@@ -15,6 +15,8 @@
 
 #include "pasteboard_observer_proxy.h"
 
+#include <cinttypes>
+
 #include "errors.h"
 #include "message_option.h"
 #include "message_parcel.h"
@@ -30,7 +32,8 @@ PasteboardObserverProxy::PasteboardObserverProxy(const sptr<IRemoteObject> &obje
 void PasteboardObserverProxy::OnPasteboardChanged()
 {
     MessageParcel data, reply;
-    MessageOption option;
+    // One-way call: the service must never wait for an observer process to handle the change.
+    MessageOption option(MessageOption::TF_ASYNC);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "write descriptor failed!");
@@ -44,5 +47,34 @@ void PasteboardObserverProxy::OnPasteboardChanged()
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
     return;
 }
+
+void PasteboardObserverProxy::OnPasteboardChanged(const PasteboardChangedEvent &event)
+{
+    SendPasteboardChanged(event);
+}
+
+bool PasteboardObserverProxy::SendPasteboardChanged(const PasteboardChangedEvent &event)
+{
+    MessageParcel data, reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start, seq = %{public}" PRIu64 ".", event.seq);
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "write descriptor failed!");
+        return false;
+    }
+    if (!data.WriteParcelable(&event)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write event failed!");
+        return false;
+    }
+
+    // A one-way send fails at once when the observer's async buffer is full.
+    int ret = Remote()->SendRequest(static_cast<int>(ON_PASTE_BOARD_CHANGE), data, reply, option);
+    if (ret != ERR_OK) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "SendRequest is failed, error code: %{public}d", ret);
+        return false;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return true;
+}
 } // namespace MiscServices
 } // namespace OHOS
@@ -54,7 +54,18 @@ int32_t PasteboardObserverStub::OnRemoteRequest(uint32_t code, MessageParcel &da
 int32_t PasteboardObserverStub::OnPasteboardChangedStub(MessageParcel &data, MessageParcel &reply)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
-    OnPasteboardChanged();
+    // Events written by older services carry no payload.
+    if (data.GetReadableBytes() == 0) {
+        OnPasteboardChanged();
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+        return ERR_OK;
+    }
+    std::unique_ptr<PasteboardChangedEvent> event(data.ReadParcelable<PasteboardChangedEvent>());
+    if (event == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read event failed.");
+        return ERR_INVALID_VALUE;
+    }
+    OnPasteboardChanged(*event);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
     return ERR_OK;
 }
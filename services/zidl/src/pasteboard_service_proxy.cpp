@@ -15,11 +15,23 @@
 
 #include "pasteboard_service_proxy.h"
 
+#include <algorithm>
 #include "iremote_broker.h"
 #include "pasteboard_common.h"
 
 namespace OHOS {
 namespace MiscServices {
+namespace {
+// ReadParcelable with the records left encoded, callers often look at the first one only.
+PasteData *ReadPasteData(MessageParcel &reply)
+{
+    if (reply.ReadInt32() == 0) {
+        return nullptr;
+    }
+    return PasteData::Unmarshalling(reply, true);
+}
+}
+
 PasteboardServiceProxy::PasteboardServiceProxy(const sptr<IRemoteObject> &object)
     : IRemoteProxy<IPasteboardService>(object)
 {
@@ -41,7 +53,8 @@ void PasteboardServiceProxy::Clear()
     }
 }
 
-void PasteboardServiceProxy::AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer)
+void PasteboardServiceProxy::AddPasteboardChangedObserver(const sptr<IPasteboardChangedObserver>& observer,
+    const std::vector<std::string> &mimeTypes)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
     if (observer == nullptr) {
@@ -58,6 +71,10 @@ void PasteboardServiceProxy::AddPasteboardChangedObserver(const sptr<IPasteboard
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
         return;
     }
+    if (!data.WriteStringVector(mimeTypes)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write mime types");
+        return;
+    }
     int32_t result = Remote()->SendRequest(ADD_OBSERVER, data, reply, option);
     if (result != ERR_NONE) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
@@ -133,13 +150,19 @@ void PasteboardServiceProxy::SetPasteData(PasteData& pasteData)
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
         return;
     }
-    if (!data.WriteParcelable(&pasteData)) {
+    VersionedPasteData versioned(pasteData, wireVersion_.load());
+    if (!data.WriteParcelable(&versioned)) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable subscribeInfo");
         return;
     }
     int32_t result = Remote()->SendRequest(SET_PASTE_DATA, data, reply, option);
     if (result != ERR_NONE) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return;
+    }
+    uint32_t serviceVersion = PASTE_DATA_WIRE_V1;
+    if (reply.GetReadableBytes() > 0 && reply.ReadUint32(serviceVersion)) {
+        wireVersion_.store(std::min(serviceVersion, static_cast<uint32_t>(PASTE_DATA_WIRE_LATEST)));
     }
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
 }
@@ -153,12 +176,16 @@ bool PasteboardServiceProxy::GetPasteData(PasteData& pasteData)
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
         return false;
     }
+    if (!data.WriteUint32(PASTE_DATA_WIRE_LATEST)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write version");
+        return false;
+    }
     int32_t result = Remote()->SendRequest(GET_PASTE_DATA, data, reply, option);
     if (result != ERR_NONE) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
         return false;
     }
-    std::unique_ptr<PasteData> pasteInfo(reply.ReadParcelable<PasteData>());
+    std::unique_ptr<PasteData> pasteInfo(ReadPasteData(reply));
     if (pasteInfo == nullptr) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "nullptr end.");
         return false;
@@ -167,5 +194,419 @@ bool PasteboardServiceProxy::GetPasteData(PasteData& pasteData)
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
     return true;
 }
+
+int64_t PasteboardServiceProxy::GetChangeCount()
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return -1;
+    }
+
+    int32_t result = Remote()->SendRequest(GET_CHANGE_COUNT, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return -1;
+    }
+    int64_t changeCount = -1;
+    if (!reply.ReadInt64(changeCount)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read change count");
+        return -1;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return changeCount;
+}
+
+bool PasteboardServiceProxy::GetPasteDataIfChanged(int64_t &changeCount, PasteData &pasteData, bool &modified)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    modified = false;
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteInt64(changeCount)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write change count");
+        return false;
+    }
+    if (!data.WriteUint32(PASTE_DATA_WIRE_LATEST)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write version");
+        return false;
+    }
+    int32_t result = Remote()->SendRequest(GET_PASTE_DATA_IF_CHANGED, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return false;
+    }
+    bool hasPasteData = false;
+    int64_t currentCount = -1;
+    bool changed = false;
+    if (!reply.ReadBool(hasPasteData) || !reply.ReadInt64(currentCount) || !reply.ReadBool(changed)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read reply header");
+        return false;
+    }
+    if (changed && hasPasteData) {
+        std::unique_ptr<PasteData> pasteInfo(ReadPasteData(reply));
+        if (pasteInfo == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read pasteData");
+            return false;
+        }
+        pasteData = *pasteInfo;
+    }
+    changeCount = currentCount;
+    modified = changed;
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return hasPasteData;
+}
+
+bool PasteboardServiceProxy::GetPasteDataSummary(PasteDataSummary &summary)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    int32_t result = Remote()->SendRequest(GET_PASTE_DATA_SUMMARY, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return false;
+    }
+    bool hasPasteData = false;
+    if (!reply.ReadBool(hasPasteData) || !hasPasteData) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "no paste data end.");
+        return false;
+    }
+    std::unique_ptr<PasteDataSummary> info(reply.ReadParcelable<PasteDataSummary>());
+    if (info == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read summary");
+        return false;
+    }
+    summary = *info;
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return true;
+}
+
+bool PasteboardServiceProxy::GetRecordAt(uint32_t index, PasteData &pasteData)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteUint32(index) || !data.WriteUint32(PASTE_DATA_WIRE_LATEST)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write request");
+        return false;
+    }
+    int32_t result = Remote()->SendRequest(GET_RECORD_AT, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return false;
+    }
+    return ReadRecordReply(reply, pasteData);
+}
+
+bool PasteboardServiceProxy::GetFirstRecord(const std::string &mimeType, PasteData &pasteData)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteString(mimeType) || !data.WriteUint32(PASTE_DATA_WIRE_LATEST)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write request");
+        return false;
+    }
+    int32_t result = Remote()->SendRequest(GET_FIRST_RECORD, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return false;
+    }
+    return ReadRecordReply(reply, pasteData);
+}
+
+uint32_t PasteboardServiceProxy::OpenRecordReader(uint32_t index, const sptr<IRemoteObject> &token,
+    std::string &mimeType, uint64_t &size)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return 0;
+    }
+    if (!data.WriteUint32(index)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write index");
+        return 0;
+    }
+    if (!data.WriteRemoteObject(token)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write token");
+        return 0;
+    }
+    int32_t result = Remote()->SendRequest(OPEN_RECORD_READER, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return 0;
+    }
+    uint32_t readerId = 0;
+    if (!reply.ReadUint32(readerId) || readerId == 0) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "no record end.");
+        return 0;
+    }
+    if (!reply.ReadString(mimeType) || !reply.ReadUint64(size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read reader info");
+        CloseRecordReader(readerId);
+        return 0;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return readerId;
+}
+
+bool PasteboardServiceProxy::ReadRecordChunk(uint32_t readerId, uint64_t offset, uint32_t length,
+    std::string &chunk)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteUint32(readerId) || !data.WriteUint64(offset) || !data.WriteUint32(length)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write request");
+        return false;
+    }
+    int32_t result = Remote()->SendRequest(READ_RECORD_CHUNK, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return false;
+    }
+    bool ok = false;
+    uint32_t size = 0;
+    if (!reply.ReadBool(ok) || !ok || !reply.ReadUint32(size) || size > length) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read chunk");
+        return false;
+    }
+    auto bytes = reply.ReadBuffer(size);
+    if (bytes == nullptr && size != 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read %{public}u bytes", size);
+        return false;
+    }
+    chunk.assign(reinterpret_cast<const char *>(bytes), size);
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return true;
+}
+
+void PasteboardServiceProxy::CloseRecordReader(uint32_t readerId)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    // nothing to wait for, and it may run from a finalizer
+    MessageOption option(MessageOption::TF_ASYNC);
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return;
+    }
+    if (!data.WriteUint32(readerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write reader id");
+        return;
+    }
+    int32_t result = Remote()->SendRequest(CLOSE_RECORD_READER, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+}
+
+uint32_t PasteboardServiceProxy::BeginPasteWriter(const sptr<IRemoteObject> &token)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return 0;
+    }
+    if (!data.WriteRemoteObject(token)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write token");
+        return 0;
+    }
+    int32_t result = Remote()->SendRequest(BEGIN_PASTE_WRITER, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return 0;
+    }
+    uint32_t writerId = 0;
+    if (!reply.ReadUint32(writerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read writer id");
+        return 0;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return writerId;
+}
+
+bool PasteboardServiceProxy::AddWriterRecord(uint32_t writerId, const std::string &mimeType, uint64_t size)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteUint32(writerId) || !data.WriteString(mimeType) || !data.WriteUint64(size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write request");
+        return false;
+    }
+    return SendWriterRequest(ADD_WRITER_RECORD, data);
+}
+
+bool PasteboardServiceProxy::AppendWriterChunk(uint32_t writerId, const char *chunk, std::size_t size)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (size > MAX_RECORD_CHUNK_SIZE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "chunk of %{public}zu bytes too large", size);
+        return false;
+    }
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteUint32(writerId) || !data.WriteUint32(static_cast<uint32_t>(size)) ||
+        !data.WriteBuffer(chunk, size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write chunk");
+        return false;
+    }
+    return SendWriterRequest(APPEND_WRITER_CHUNK, data);
+}
+
+bool PasteboardServiceProxy::CommitPasteWriter(uint32_t writerId)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteUint32(writerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write writer id");
+        return false;
+    }
+    return SendWriterRequest(COMMIT_PASTE_WRITER, data);
+}
+
+void PasteboardServiceProxy::AbortPasteWriter(uint32_t writerId)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    MessageParcel data, reply;
+    // waited for, unlike closing a reader: a commit sent after it must find the writer gone
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return;
+    }
+    if (!data.WriteUint32(writerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write writer id");
+        return;
+    }
+    int32_t result = Remote()->SendRequest(ABORT_PASTE_WRITER, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+}
+
+bool PasteboardServiceProxy::SendWriterRequest(uint32_t code, MessageParcel &data)
+{
+    MessageParcel reply;
+    MessageOption option;
+    int32_t result = Remote()->SendRequest(code, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+        return false;
+    }
+    bool ok = false;
+    if (!reply.ReadBool(ok)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read reply");
+        return false;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return ok;
+}
+
+bool PasteboardServiceProxy::ReadRecordReply(MessageParcel &reply, PasteData &pasteData)
+{
+    bool found = false;
+    if (!reply.ReadBool(found) || !found) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "no record end.");
+        return false;
+    }
+    std::unique_ptr<PasteData> pasteInfo(ReadPasteData(reply));
+    if (pasteInfo == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to read pasteData");
+        return false;
+    }
+    pasteData = *pasteInfo;
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+    return true;
+}
+
+void PasteboardServiceProxy::AddPasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (observer == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "observer nullptr");
+        return;
+    }
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return;
+    }
+    if (!data.WriteRemoteObject(observer->AsObject())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return;
+    }
+    int32_t result = Remote()->SendRequest(ADD_EVENT_OBSERVER, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+}
+
+void PasteboardServiceProxy::RemovePasteboardEventObserver(const sptr<IPasteboardChangedObserver>& observer)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "start.");
+    if (observer == nullptr) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "observer nullptr");
+        return;
+    }
+    MessageParcel data, reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return;
+    }
+    if (!data.WriteRemoteObject(observer->AsObject())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "Failed to write parcelable");
+        return;
+    }
+    int32_t result = Remote()->SendRequest(DELETE_EVENT_OBSERVER, data, reply, option);
+    if (result != ERR_NONE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_CLIENT, "failed, error code is: %{public}d", result);
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "end.");
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include "pasteboard_service_stub.h"
 
+#include <algorithm>
 #include "errors.h"
 #include "paste_data.h"
 #include "pasteboard_common.h"
@@ -22,6 +23,21 @@
 
 namespace OHOS {
 namespace MiscServices {
+namespace {
+const size_t MAX_OBSERVER_MIME_TYPES = 32;
+
+// Newest paste data layout the caller can decode, older clients do not send one.
+uint32_t ReadAcceptedVersion(MessageParcel &data)
+{
+    uint32_t version = PASTE_DATA_WIRE_V1;
+    if (data.GetReadableBytes() > 0 && !data.ReadUint32(version)) {
+        return PASTE_DATA_WIRE_V1;
+    }
+    return std::min(std::max(version, static_cast<uint32_t>(PASTE_DATA_WIRE_V1)),
+        static_cast<uint32_t>(PASTE_DATA_WIRE_LATEST));
+}
+}
+
 PasteboardServiceStub::PasteboardServiceStub()
 {
     memberFuncMap_[static_cast<uint32_t>(GET_PASTE_DATA)] = &PasteboardServiceStub::OnGetPasteData;
@@ -34,6 +50,24 @@ PasteboardServiceStub::PasteboardServiceStub()
         &PasteboardServiceStub::OnRemovePasteboardChangedObserver;
     memberFuncMap_[static_cast<uint32_t>(DELETE_ALL_OBSERVER)] =
         &PasteboardServiceStub::OnRemoveAllChangedObserver;
+    memberFuncMap_[static_cast<uint32_t>(ADD_EVENT_OBSERVER)] =
+        &PasteboardServiceStub::OnAddPasteboardEventObserver;
+    memberFuncMap_[static_cast<uint32_t>(DELETE_EVENT_OBSERVER)] =
+        &PasteboardServiceStub::OnRemovePasteboardEventObserver;
+    memberFuncMap_[static_cast<uint32_t>(GET_CHANGE_COUNT)] = &PasteboardServiceStub::OnGetChangeCount;
+    memberFuncMap_[static_cast<uint32_t>(GET_PASTE_DATA_IF_CHANGED)] =
+        &PasteboardServiceStub::OnGetPasteDataIfChanged;
+    memberFuncMap_[static_cast<uint32_t>(GET_PASTE_DATA_SUMMARY)] = &PasteboardServiceStub::OnGetPasteDataSummary;
+    memberFuncMap_[static_cast<uint32_t>(GET_RECORD_AT)] = &PasteboardServiceStub::OnGetRecordAt;
+    memberFuncMap_[static_cast<uint32_t>(GET_FIRST_RECORD)] = &PasteboardServiceStub::OnGetFirstRecord;
+    memberFuncMap_[static_cast<uint32_t>(OPEN_RECORD_READER)] = &PasteboardServiceStub::OnOpenRecordReader;
+    memberFuncMap_[static_cast<uint32_t>(READ_RECORD_CHUNK)] = &PasteboardServiceStub::OnReadRecordChunk;
+    memberFuncMap_[static_cast<uint32_t>(CLOSE_RECORD_READER)] = &PasteboardServiceStub::OnCloseRecordReader;
+    memberFuncMap_[static_cast<uint32_t>(BEGIN_PASTE_WRITER)] = &PasteboardServiceStub::OnBeginPasteWriter;
+    memberFuncMap_[static_cast<uint32_t>(ADD_WRITER_RECORD)] = &PasteboardServiceStub::OnAddWriterRecord;
+    memberFuncMap_[static_cast<uint32_t>(APPEND_WRITER_CHUNK)] = &PasteboardServiceStub::OnAppendWriterChunk;
+    memberFuncMap_[static_cast<uint32_t>(COMMIT_PASTE_WRITER)] = &PasteboardServiceStub::OnCommitPasteWriter;
+    memberFuncMap_[static_cast<uint32_t>(ABORT_PASTE_WRITER)] = &PasteboardServiceStub::OnAbortPasteWriter;
 }
 
 int32_t PasteboardServiceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply,
@@ -73,13 +107,15 @@ int32_t PasteboardServiceStub::OnClear(MessageParcel &data, MessageParcel &reply
 int32_t PasteboardServiceStub::OnGetPasteData(MessageParcel &data, MessageParcel &reply)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, " start.");
+    uint32_t version = ReadAcceptedVersion(data);
     PasteData pasteData {};
     auto hasPasteData = GetPasteData(pasteData);
     if (!hasPasteData) {
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, " end.");
         return ERR_INVALID_VALUE;
     }
-    if (!reply.WriteParcelable(&pasteData)) {
+    VersionedPasteData versioned(pasteData, version);
+    if (!reply.WriteParcelable(&versioned)) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write parcelable pasteData");
         return ERR_INVALID_VALUE;
     }
@@ -98,13 +134,20 @@ int32_t PasteboardServiceStub::OnHasPasteData(MessageParcel &data, MessageParcel
 int32_t PasteboardServiceStub::OnSetPasteData(MessageParcel &data, MessageParcel &reply)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, " start.");
-    std::unique_ptr<PasteData> pasteData(data.ReadParcelable<PasteData>());
+    // The clip is kept as the records came in: the walk checks their framing and types and indexes them,
+    // readers of the same layout get the bytes or shared regions back, only other layouts are re-encoded.
+    std::unique_ptr<PasteData> pasteData;
+    if (data.ReadInt32() != 0) {
+        pasteData.reset(PasteData::Unmarshalling(data, true));
+    }
     if (!pasteData) {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, " start.");
         return ERR_INVALID_VALUE;
     }
 
     SetPasteData(*pasteData);
+    // Tells the client which layout it may use from now on, older clients never read it.
+    reply.WriteUint32(PASTE_DATA_WIRE_LATEST);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, " end.");
     return ERR_OK;
 }
@@ -121,7 +164,17 @@ int32_t PasteboardServiceStub::OnAddPasteboardChangedObserver(MessageParcel &dat
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "callback nullptr");
         return ERR_INVALID_VALUE;
     }
-    AddPasteboardChangedObserver(callback);
+    // Older clients send no filter at all, which subscribes to every change.
+    std::vector<std::string> mimeTypes;
+    if (data.GetReadableBytes() > 0 && !data.ReadStringVector(&mimeTypes)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read mime types failed");
+        return ERR_INVALID_VALUE;
+    }
+    if (mimeTypes.size() > MAX_OBSERVER_MIME_TYPES) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "too many mime types: %{public}zu", mimeTypes.size());
+        return ERR_INVALID_VALUE;
+    }
+    AddPasteboardChangedObserver(callback, mimeTypes);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
     return ERR_OK;
 }
@@ -151,6 +204,286 @@ int32_t PasteboardServiceStub::OnRemoveAllChangedObserver(MessageParcel &data, M
     return ERR_OK;
 }
 
+int32_t PasteboardServiceStub::OnAddPasteboardEventObserver(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    sptr<IRemoteObject> obj = data.ReadRemoteObject();
+    if (obj == nullptr) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "obj nullptr");
+        return ERR_INVALID_VALUE;
+    }
+    sptr<IPasteboardChangedObserver> callback = iface_cast<IPasteboardChangedObserver>(obj);
+    if (callback == nullptr) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "callback nullptr");
+        return ERR_INVALID_VALUE;
+    }
+    AddPasteboardEventObserver(callback);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnRemovePasteboardEventObserver(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    sptr<IRemoteObject> obj = data.ReadRemoteObject();
+    if (obj == nullptr) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "obj nullptr");
+        return ERR_INVALID_VALUE;
+    }
+    sptr<IPasteboardChangedObserver> callback = iface_cast<IPasteboardChangedObserver>(obj);
+    if (callback == nullptr) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "callback nullptr");
+        return ERR_INVALID_VALUE;
+    }
+    RemovePasteboardEventObserver(callback);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnGetChangeCount(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    if (!reply.WriteInt64(GetChangeCount())) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write change count");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnGetPasteDataIfChanged(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    int64_t changeCount = data.ReadInt64();
+    uint32_t version = ReadAcceptedVersion(data);
+    PasteData pasteData {};
+    bool modified = false;
+    bool hasPasteData = GetPasteDataIfChanged(changeCount, pasteData, modified);
+    if (!reply.WriteBool(hasPasteData) || !reply.WriteInt64(changeCount) || !reply.WriteBool(modified)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reply header");
+        return ERR_INVALID_VALUE;
+    }
+    // An unchanged clip is answered with the header only, the data is sent just when it moved.
+    VersionedPasteData versioned(pasteData, version);
+    if (modified && hasPasteData && !reply.WriteParcelable(&versioned)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write parcelable pasteData");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnGetPasteDataSummary(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    PasteDataSummary summary;
+    bool hasPasteData = GetPasteDataSummary(summary);
+    if (!reply.WriteBool(hasPasteData)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reply header");
+        return ERR_INVALID_VALUE;
+    }
+    if (hasPasteData && !reply.WriteParcelable(&summary)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write parcelable summary");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnGetRecordAt(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t index = 0;
+    if (!data.ReadUint32(index)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read index failed");
+        return ERR_INVALID_VALUE;
+    }
+    uint32_t version = ReadAcceptedVersion(data);
+    PasteData pasteData {};
+    bool found = GetRecordAt(index, pasteData);
+    return WriteRecordReply(found, pasteData, version, reply);
+}
+
+int32_t PasteboardServiceStub::OnGetFirstRecord(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    std::string mimeType;
+    if (!data.ReadString(mimeType)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read mime type failed");
+        return ERR_INVALID_VALUE;
+    }
+    uint32_t version = ReadAcceptedVersion(data);
+    PasteData pasteData {};
+    bool found = GetFirstRecord(mimeType, pasteData);
+    return WriteRecordReply(found, pasteData, version, reply);
+}
+
+int32_t PasteboardServiceStub::OnOpenRecordReader(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t index = 0;
+    if (!data.ReadUint32(index)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read index failed");
+        return ERR_INVALID_VALUE;
+    }
+    sptr<IRemoteObject> token = data.ReadRemoteObject();
+    std::string mimeType;
+    uint64_t size = 0;
+    uint32_t readerId = OpenRecordReader(index, token, mimeType, size);
+    if (!reply.WriteUint32(readerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reader id");
+        CloseRecordReader(readerId);
+        return ERR_INVALID_VALUE;
+    }
+    if (readerId != 0 && (!reply.WriteString(mimeType) || !reply.WriteUint64(size))) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reader info");
+        CloseRecordReader(readerId);
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnReadRecordChunk(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t readerId = 0;
+    uint64_t offset = 0;
+    uint32_t length = 0;
+    if (!data.ReadUint32(readerId) || !data.ReadUint64(offset) || !data.ReadUint32(length)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read request failed");
+        return ERR_INVALID_VALUE;
+    }
+    std::string chunk;
+    bool ok = ReadRecordChunk(readerId, offset, std::min(length, MAX_RECORD_CHUNK_SIZE), chunk);
+    if (!reply.WriteBool(ok)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reply header");
+        return ERR_INVALID_VALUE;
+    }
+    if (ok && (!reply.WriteUint32(static_cast<uint32_t>(chunk.size())) ||
+        !reply.WriteBuffer(chunk.data(), chunk.size()))) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write chunk");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnCloseRecordReader(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t readerId = 0;
+    if (!data.ReadUint32(readerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read reader id failed");
+        return ERR_INVALID_VALUE;
+    }
+    CloseRecordReader(readerId);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnBeginPasteWriter(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    sptr<IRemoteObject> token = data.ReadRemoteObject();
+    uint32_t writerId = BeginPasteWriter(token);
+    if (!reply.WriteUint32(writerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write writer id");
+        AbortPasteWriter(writerId);
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnAddWriterRecord(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t writerId = 0;
+    std::string mimeType;
+    uint64_t size = 0;
+    if (!data.ReadUint32(writerId) || !data.ReadString(mimeType) || !data.ReadUint64(size)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read request failed");
+        return ERR_INVALID_VALUE;
+    }
+    if (!reply.WriteBool(AddWriterRecord(writerId, mimeType, size))) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reply");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnAppendWriterChunk(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t writerId = 0;
+    uint32_t size = 0;
+    if (!data.ReadUint32(writerId) || !data.ReadUint32(size) || size > MAX_RECORD_CHUNK_SIZE) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read request failed");
+        return ERR_INVALID_VALUE;
+    }
+    // the bytes are taken from the parcel in place, the service copies them once into the record
+    auto chunk = data.ReadBuffer(size);
+    if (chunk == nullptr && size != 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read %{public}u bytes failed", size);
+        return ERR_INVALID_VALUE;
+    }
+    bool ok = AppendWriterChunk(writerId, reinterpret_cast<const char *>(chunk), size);
+    if (!reply.WriteBool(ok)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reply");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnCommitPasteWriter(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t writerId = 0;
+    if (!data.ReadUint32(writerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read writer id failed");
+        return ERR_INVALID_VALUE;
+    }
+    if (!reply.WriteBool(CommitPasteWriter(writerId))) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reply");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::OnAbortPasteWriter(MessageParcel &data, MessageParcel &reply)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "start.");
+    uint32_t writerId = 0;
+    if (!data.ReadUint32(writerId)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "read writer id failed");
+        return ERR_INVALID_VALUE;
+    }
+    AbortPasteWriter(writerId);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
+int32_t PasteboardServiceStub::WriteRecordReply(bool found, PasteData &pasteData, uint32_t version,
+    MessageParcel &reply)
+{
+    if (!reply.WriteBool(found)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write reply header");
+        return ERR_INVALID_VALUE;
+    }
+    // The one record goes out in a clip of its own, so it travels in whatever form the service holds it.
+    VersionedPasteData versioned(pasteData, version);
+    if (found && !reply.WriteParcelable(&versioned)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to write parcelable pasteData");
+        return ERR_INVALID_VALUE;
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "end.");
+    return ERR_OK;
+}
+
 PasteboardServiceStub::~PasteboardServiceStub()
 {
     memberFuncMap_.clear();
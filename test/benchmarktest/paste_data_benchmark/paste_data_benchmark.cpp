@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <limits>
+#include <memory>
+#include <string>
+#include "paste_data.h"
+#include "record_task_pool.h"
+
+using namespace OHOS;
+using namespace OHOS::MiscServices;
+
+namespace {
+constexpr int64_t MIN_RECORDS = 1;
+constexpr int64_t MAX_RECORDS = 32;
+constexpr int64_t MIN_RECORD_SIZE = 4 * 1024;
+constexpr int64_t MAX_RECORD_SIZE = 256 * 1024;
+constexpr int64_t RANGE_MULTIPLIER = 4;
+enum : int64_t { MODE_SERIAL = 0, MODE_PARALLEL };
+
+// Arguments: record count, bytes per record, serial or parallel.
+PasteData MakeClip(benchmark::State &state)
+{
+    RecordTaskPool::GetInstance().SetMinBytes(
+        state.range(2) == MODE_PARALLEL ? 0 : std::numeric_limits<std::size_t>::max());
+    state.SetLabel(state.range(2) == MODE_PARALLEL ? "parallel" : "serial");
+    // HTML fragments of a multi-selection copy, with some non-ASCII text in each
+    const std::string piece = "<li>\xe4\xbd\xa0\xe5\xa5\xbd item</li>";
+    PasteData data;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        std::string html;
+        while (static_cast<int64_t>(html.size() + piece.size()) <= state.range(1)) {
+            html += piece;
+        }
+        data.AddHtmlRecord(std::move(html));
+    }
+    return data;
+}
+
+void SetBytes(benchmark::State &state)
+{
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+void BM_Marshalling(benchmark::State &state)
+{
+    PasteData data = MakeClip(state);
+    std::size_t size = data.SerializedSize();
+    for (auto _ : state) {
+        Parcel parcel;
+        parcel.SetMaxCapacity(size);
+        benchmark::DoNotOptimize(data.Marshalling(parcel));
+    }
+    SetBytes(state);
+}
+
+void BM_Unmarshalling(benchmark::State &state)
+{
+    PasteData data = MakeClip(state);
+    Parcel parcel;
+    parcel.SetMaxCapacity(data.SerializedSize());
+    data.Marshalling(parcel);
+    for (auto _ : state) {
+        parcel.RewindRead(0);
+        std::unique_ptr<PasteData> decoded(PasteData::Unmarshalling(parcel));
+        benchmark::DoNotOptimize(decoded.get());
+    }
+    SetBytes(state);
+}
+
+// A clip a V1 peer set, held encoded by the service, written to a V2 peer.
+void BM_WriteHeldClip(benchmark::State &state)
+{
+    PasteData data = MakeClip(state);
+    Parcel parcel;
+    parcel.SetMaxCapacity(data.SerializedSize());
+    data.Marshalling(parcel);
+    std::unique_ptr<PasteData> held(PasteData::Unmarshalling(parcel, true));
+    std::size_t size = data.SerializedSize(PASTE_DATA_WIRE_V2);
+    for (auto _ : state) {
+        Parcel reply;
+        reply.SetMaxCapacity(size);
+        benchmark::DoNotOptimize(held->Marshalling(reply, PASTE_DATA_WIRE_V2));
+    }
+    SetBytes(state);
+}
+
+void ClipArgs(benchmark::internal::Benchmark *bench)
+{
+    for (int64_t records = MIN_RECORDS; records <= MAX_RECORDS; records *= RANGE_MULTIPLIER) {
+        for (int64_t size = MIN_RECORD_SIZE; size <= MAX_RECORD_SIZE; size *= RANGE_MULTIPLIER) {
+            bench->Args({ records, size, MODE_SERIAL });
+            bench->Args({ records, size, MODE_PARALLEL });
+        }
+    }
+}
+} // namespace
+
+BENCHMARK(BM_Marshalling)->Apply(ClipArgs)->UseRealTime();
+BENCHMARK(BM_Unmarshalling)->Apply(ClipArgs)->UseRealTime();
+BENCHMARK(BM_WriteHeldClip)->Apply(ClipArgs)->UseRealTime();
+
+BENCHMARK_MAIN();
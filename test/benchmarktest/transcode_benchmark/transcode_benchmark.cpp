@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <string>
+#include "string_ex.h"
+#include "utf_transcoder.h"
+
+using namespace OHOS;
+using namespace OHOS::MiscServices;
+
+namespace {
+// PasteDataRecord refuses text of MAX_TEXT_LEN bytes or more.
+constexpr int64_t MAX_TEXT_LEN = 500 * 1024;
+constexpr int64_t MIN_TEXT_LEN = 64;
+constexpr int RANGE_MULTIPLIER = 8;
+
+// ASCII only, the common case for copied code and URLs.
+std::string MakeAscii(int64_t size)
+{
+    const std::string piece = "<p class=\"body\">The quick brown fox jumps over the lazy dog.</p>\n";
+    std::string text;
+    while (static_cast<int64_t>(text.size() + piece.size()) <= size) {
+        text += piece;
+    }
+    text.append(size - text.size(), 'x');
+    return text;
+}
+
+// Markup around CJK and emoji text, roughly a quarter of it ASCII.
+std::string MakeMixed(int64_t size)
+{
+    const std::string piece = "<p>\xe4\xbd\xa0\xe5\xa5\xbd\xef\xbc\x8c\xe4\xb8\x96\xe7\x95\x8c \xf0\x9f\x98\x80</p>";
+    std::string text;
+    while (static_cast<int64_t>(text.size() + piece.size()) <= size) {
+        text += piece;
+    }
+    text.append(size - text.size(), 'x');
+    return text;
+}
+
+void SetBytes(benchmark::State &state)
+{
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.SetLabel(UtfTranscoder::GetBackend());
+}
+
+template<std::string (*Make)(int64_t)>
+void BM_StringEx8To16(benchmark::State &state)
+{
+    std::string text = Make(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Str8ToStr16(text));
+    }
+    SetBytes(state);
+}
+
+template<std::string (*Make)(int64_t)>
+void BM_Transcoder8To16(benchmark::State &state)
+{
+    std::string text = Make(state.range(0));
+    for (auto _ : state) {
+        std::u16string result;
+        benchmark::DoNotOptimize(UtfTranscoder::Utf8ToUtf16(text, result));
+        benchmark::DoNotOptimize(result.data());
+    }
+    SetBytes(state);
+}
+
+template<std::string (*Make)(int64_t)>
+void BM_StringEx16To8(benchmark::State &state)
+{
+    std::u16string text = Str8ToStr16(Make(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Str16ToStr8(text));
+    }
+    SetBytes(state);
+}
+
+template<std::string (*Make)(int64_t)>
+void BM_Transcoder16To8(benchmark::State &state)
+{
+    std::u16string text = Str8ToStr16(Make(state.range(0)));
+    for (auto _ : state) {
+        std::string result;
+        benchmark::DoNotOptimize(UtfTranscoder::Utf16ToUtf8(text, result));
+        benchmark::DoNotOptimize(result.data());
+    }
+    SetBytes(state);
+}
+} // namespace
+
+#define TRANSCODE_BENCHMARK(func, make) \
+    BENCHMARK_TEMPLATE(func, make)->RangeMultiplier(RANGE_MULTIPLIER)->Range(MIN_TEXT_LEN, MAX_TEXT_LEN - 1)
+
+TRANSCODE_BENCHMARK(BM_StringEx8To16, MakeAscii);
+TRANSCODE_BENCHMARK(BM_Transcoder8To16, MakeAscii);
+TRANSCODE_BENCHMARK(BM_StringEx8To16, MakeMixed);
+TRANSCODE_BENCHMARK(BM_Transcoder8To16, MakeMixed);
+TRANSCODE_BENCHMARK(BM_StringEx16To8, MakeAscii);
+TRANSCODE_BENCHMARK(BM_Transcoder16To8, MakeAscii);
+TRANSCODE_BENCHMARK(BM_StringEx16To8, MakeMixed);
+TRANSCODE_BENCHMARK(BM_Transcoder16To8, MakeMixed);
+
+BENCHMARK_MAIN();